@@ -4,7 +4,12 @@
  */
 #include "Arduino_DataBus.h"
 
-Arduino_DataBus::Arduino_DataBus() {}
+Arduino_DataBus::Arduino_DataBus()
+{
+#if !defined(LITTLE_FOOT_PRINT)
+  _batch_operations = NULL;
+#endif // !defined(LITTLE_FOOT_PRINT)
+}
 
 void Arduino_DataBus::writeC8D8(uint8_t c, uint8_t d)
 {
@@ -72,6 +77,7 @@ void Arduino_DataBus::sendData16(uint16_t d)
 
 void Arduino_DataBus::batchOperation(const uint8_t *operations, size_t len)
 {
+#if defined(LITTLE_FOOT_PRINT)
   for (size_t i = 0; i < len; ++i)
   {
     uint8_t l = 0;
@@ -113,7 +119,7 @@ void Arduino_DataBus::batchOperation(const uint8_t *operations, size_t len)
       delay(operations[++i]);
       break;
     default:
-      printf("Unknown operation id at %d: %d", i, operations[i]);
+      printf("Unknown operation id at %u: %d", (unsigned int)i, operations[i]);
       break;
     }
     while (l--)
@@ -121,27 +127,252 @@ void Arduino_DataBus::batchOperation(const uint8_t *operations, size_t len)
       write(operations[++i]);
     }
   }
+#else  // !defined(LITTLE_FOOT_PRINT)
+  runOperations(operations, len, 0, false);
+#endif // !defined(LITTLE_FOOT_PRINT)
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+void Arduino_DataBus::batchOperationStart(const uint8_t *operations, size_t len)
+{
+  _batch_operations = operations;
+  _batch_len = len;
+  _batch_pos = 0;
+  _batch_wait_ms = 0;
+}
+
+bool Arduino_DataBus::batchOperationPoll()
+{
+  if (!_batch_operations)
+  {
+    return true;
+  }
+  if (_batch_wait_ms)
+  {
+    if ((millis() - _batch_wait_start) < _batch_wait_ms)
+    {
+      return false;
+    }
+    _batch_wait_ms = 0;
+  }
+
+  _batch_pos = runOperations(_batch_operations, _batch_len, _batch_pos, true);
+  if ((_batch_pos >= _batch_len) && (!_batch_wait_ms))
+  {
+    _batch_operations = NULL;
+    return true;
+  }
+  return false;
+}
+
+// Runs steps from i, the data bytes between commands go out as one writeBytes().
+// Returns where to resume, past a DELAY when stop_at_delay is set.
+size_t Arduino_DataBus::runOperations(const uint8_t *operations, size_t len, size_t i, bool stop_at_delay)
+{
+  uint8_t buf[BATCH_DATA_BUFFER];
+  uint8_t n = 0;
+  for (; i < len; ++i)
+  {
+    uint8_t l = 0;
+    uint8_t op = operations[i];
+    if ((n > 0) && (op != WRITE_DATA_8) && (op != WRITE_DATA_16) && (op != WRITE_BYTES))
+    {
+      writeBatchData(buf, n);
+      n = 0;
+    }
+    switch (op)
+    {
+    case BEGIN_WRITE:
+      beginWrite();
+      break;
+    case WRITE_C8_D16:
+      l++;
+      /* fall through */
+    case WRITE_C8_D8:
+      l++;
+      /* fall through */
+    case WRITE_COMMAND_8:
+      writeCommand(operations[++i]);
+      break;
+    case WRITE_C16_D16:
+      l = 2;
+      /* fall through */
+    case WRITE_COMMAND_16:
+      _data16.msb = operations[++i];
+      _data16.lsb = operations[++i];
+      writeCommand16(_data16.value);
+      break;
+    case WRITE_DATA_8:
+      l = 1;
+      break;
+    case WRITE_DATA_16:
+      l = 2;
+      break;
+    case WRITE_BYTES:
+      l = operations[++i];
+      break;
+    case END_WRITE:
+      endWrite();
+      break;
+    case DELAY:
+      if (stop_at_delay)
+      {
+        _batch_wait_ms = operations[++i];
+        _batch_wait_start = millis();
+        return i + 1;
+      }
+      delay(operations[++i]);
+      break;
+    default:
+      printf("Unknown operation id at %u: %d", (unsigned int)i, operations[i]);
+      break;
+    }
+    while (l--)
+    {
+      buf[n++] = operations[++i];
+      if (n == BATCH_DATA_BUFFER)
+      {
+        writeBytes(buf, n);
+        n = 0;
+      }
+    }
+  }
+  writeBatchData(buf, n);
+  return i;
 }
 
+void Arduino_DataBus::writeBatchData(uint8_t *data, uint8_t len)
+{
+  if (len == 1)
+  {
+    write(data[0]);
+  }
+  else if (len > 1)
+  {
+    writeBytes(data, len);
+  }
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 #if !defined(LITTLE_FOOT_PRINT)
+// chunks are looked up into wire order and sent with one writeBytes() each
 void Arduino_DataBus::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len)
 {
-  while (len--)
+  uint32_t buf[INDEXED_BUFFER_PIXELS / 2];
+  uint32_t xferLen;
+  while (len)
   {
-    write16(idx[*(data++)]);
+    xferLen = (len < INDEXED_BUFFER_PIXELS) ? len : INDEXED_BUFFER_PIXELS;
+    expandIndexedPixels((uint16_t *)buf, data, idx, xferLen);
+    writeBytes((uint8_t *)buf, xferLen * 2);
+    data += xferLen;
+    len -= xferLen;
   }
 }
 
 void Arduino_DataBus::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len)
 {
-  uint8_t *d = data;
+  uint32_t buf[INDEXED_BUFFER_PIXELS / 2];
+  uint32_t xferLen;
+  while (len)
+  {
+    xferLen = (len < (INDEXED_BUFFER_PIXELS / 2)) ? len : (INDEXED_BUFFER_PIXELS / 2);
+    expandIndexedPixelsDouble((uint16_t *)buf, data, idx, xferLen);
+    writeBytes((uint8_t *)buf, xferLen * 4);
+    data += xferLen;
+    len -= xferLen;
+  }
+}
+
+void Arduino_DataBus::expandIndexedPixels(uint16_t *dst, const uint8_t *src, const uint16_t *idx, uint32_t len)
+{
+  uint16_t p1, p2;
+  if ((((uintptr_t)dst) & 2) && len)
+  {
+    p1 = idx[*src++];
+    MSB_16_SET(*dst++, p1);
+    len--;
+  }
+  // four pixels per round, stored as two words
+  uint32_t *d = (uint32_t *)dst;
+  for (uint32_t i = len >> 2; i > 0; i--)
+  {
+    p1 = idx[src[0]];
+    p2 = idx[src[1]];
+    MSB_32_16_16_SET(d[0], p1, p2);
+    p1 = idx[src[2]];
+    p2 = idx[src[3]];
+    MSB_32_16_16_SET(d[1], p1, p2);
+    src += 4;
+    d += 2;
+  }
+  dst = (uint16_t *)d;
+  len &= 3;
+  while (len--)
+  {
+    p1 = idx[*src++];
+    MSB_16_SET(*dst++, p1);
+  }
+}
+
+void Arduino_DataBus::expandIndexedPixelsDouble(uint16_t *dst, const uint8_t *src, const uint16_t *idx, uint32_t len)
+{
+  uint16_t p;
+  if (((uintptr_t)dst) & 2)
+  {
+    while (len--)
+    {
+      p = idx[*src++];
+      MSB_16_SET(p, p);
+      *dst++ = p;
+      *dst++ = p;
+    }
+    return;
+  }
+  uint32_t *d = (uint32_t *)dst;
   while (len--)
   {
-    _data16.value = idx[*(d++)];
-    write(_data16.msb);
-    write(_data16.lsb);
-    write(_data16.msb);
-    write(_data16.lsb);
+    p = idx[*src++];
+    MSB_32_16_16_SET(*d++, p, p);
+  }
+}
+
+void Arduino_DataBus::swapPixels(uint16_t *dst, const uint16_t *src, uint32_t len)
+{
+  uint16_t p;
+  if ((((uintptr_t)dst ^ (uintptr_t)src) & 2) == 0) // same word alignment
+  {
+    if ((((uintptr_t)src) & 2) && len)
+    {
+      p = *src++;
+      MSB_16_SET(*dst++, p);
+      len--;
+    }
+    const uint32_t *s = (const uint32_t *)src;
+    uint32_t *d = (uint32_t *)dst;
+    uint32_t v;
+    for (uint32_t i = len >> 1; i > 0; i--)
+    {
+      v = *s++;
+      MSB_16_PAIR_SET(*d++, v);
+    }
+    src = (const uint16_t *)s;
+    dst = (uint16_t *)d;
+    len &= 1;
+  }
+  while (len--)
+  {
+    p = *src++;
+    MSB_16_SET(*dst++, p);
+  }
+}
+
+void Arduino_DataBus::writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t done, void *arg)
+{
+  writePixels(data, len);
+  if (done)
+  {
+    done(arg);
   }
 }
 #endif // !defined(LITTLE_FOOT_PRINT)
@@ -119,6 +119,18 @@ typedef volatile ARDUINOGFX_PORT_t *PORTreg_t;
   {                                                                 \
     (var) = ((uint32_t)a[0] << 8 | a[1] | a[2] << 24 | a[3] << 16); \
   }
+// swap the bytes of both 16-bit halves, i.e. two pixels at once
+#if defined(ARDUINO_ARCH_STM32)
+#define MSB_16_PAIR_SET(var, val) \
+  {                               \
+    (var) = __REV16(val);         \
+  }
+#else
+#define MSB_16_PAIR_SET(var, val)                                      \
+  {                                                                    \
+    (var) = (((val)&0xFF00FF00UL) >> 8) | (((val)&0x00FF00FFUL) << 8); \
+  }
+#endif
 
 #if defined(ESP32)
 #define INLINE __attribute__((always_inline)) inline
@@ -229,6 +241,36 @@ typedef enum
   DELAY,
 } spi_operation_type_t;
 
+// Length of the batchOperation() step at operations[i], running past len for unknown ids
+constexpr size_t gfx_batch_operation_size(const uint8_t *operations, size_t len, size_t i)
+{
+  return ((operations[i] == BEGIN_WRITE) || (operations[i] == END_WRITE)) ? 1
+         : ((operations[i] == WRITE_COMMAND_8) || (operations[i] == WRITE_DATA_8) || (operations[i] == DELAY)) ? 2
+         : ((operations[i] == WRITE_COMMAND_16) || (operations[i] == WRITE_DATA_16) || (operations[i] == WRITE_C8_D8)) ? 3
+         : (operations[i] == WRITE_C8_D16) ? 4
+         : (operations[i] == WRITE_C16_D16) ? 5
+         : ((operations[i] == WRITE_BYTES) && ((i + 1) < len)) ? (2 + operations[i + 1])
+                                                              : (len + 1);
+}
+
+// For static_assert(): true when a script ends exactly on a step boundary
+constexpr bool gfx_batch_operations_valid(const uint8_t *operations, size_t len, size_t i = 0)
+{
+  return (i == len) ? true
+         : (i > len) ? false
+                     : gfx_batch_operations_valid(operations, len, i + gfx_batch_operation_size(operations, len, i));
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+#define BATCH_DATA_BUFFER 16     // data bytes of a script collected into one writeBytes()
+#define INDEXED_BUFFER_PIXELS 32 // pixels looked up per writeBytes() by writeIndexedPixels()
+#endif
+
+#if !defined(LITTLE_FOOT_PRINT)
+// Called once an asynchronous transfer, and anything queued before it, has completed
+typedef void (*gfx_async_done_cb_t)(void *arg);
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 union
 {
   uint16_t value;
@@ -267,17 +309,54 @@ public:
   void sendData16(uint16_t d);
 
   void batchOperation(const uint8_t *operations, size_t len);
+#if !defined(LITTLE_FOOT_PRINT)
+  // Same script, but DELAY steps return to the caller instead of blocking
+  void batchOperationStart(const uint8_t *operations, size_t len);
+  bool batchOperationPoll(); // true once the whole script has run
+#endif // !defined(LITTLE_FOOT_PRINT)
 
 #if !defined(LITTLE_FOOT_PRINT)
   virtual void writeBytes(uint8_t *data, uint32_t len) = 0;
   virtual void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) = 0;
   virtual void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len);
   virtual void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len);
+
+  // True when writePixels() (native order) or writeBytes() (big_endian) sends data straight from memory
+  virtual bool supportsZeroCopy(const void *data, bool big_endian)
+  {
+    UNUSED(data);
+    UNUSED(big_endian);
+    return false;
+  }
+
+  // Copy pixels converting between native and big-endian (wire) byte order, dst may equal src
+  static void swapPixels(uint16_t *dst, const uint16_t *src, uint32_t len);
+  // Look up palette indices into big-endian (wire order) pixels, the Double one writes each pixel twice
+  static void expandIndexedPixels(uint16_t *dst, const uint8_t *src, const uint16_t *idx, uint32_t len);
+  static void expandIndexedPixelsDouble(uint16_t *dst, const uint8_t *src, const uint16_t *idx, uint32_t len);
+
+  // Asynchronous transfers, buses without DMA complete them before returning
+  virtual bool supportsAsync() { return false; }
+  virtual void writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t done = NULL, void *arg = NULL);
+  virtual bool isBusy() { return false; }
+  virtual void waitAsync() {}
 #endif // !defined(LITTLE_FOOT_PRINT)
 
 protected:
+#if !defined(LITTLE_FOOT_PRINT)
+  size_t runOperations(const uint8_t *operations, size_t len, size_t i, bool stop_at_delay);
+  void writeBatchData(uint8_t *data, uint8_t len);
+#endif // !defined(LITTLE_FOOT_PRINT)
+
   int32_t _speed;
   int8_t _dataMode;
+
+#if !defined(LITTLE_FOOT_PRINT)
+  const uint8_t *_batch_operations;
+  size_t _batch_len, _batch_pos;
+  uint32_t _batch_wait_start;
+  uint8_t _batch_wait_ms;
+#endif // !defined(LITTLE_FOOT_PRINT)
 };
 
 #endif // _ARDUINO_DATABUS_H_
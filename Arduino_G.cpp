@@ -13,4 +13,183 @@ Arduino_G::Arduino_G(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h)
 {
 }
 
+/**************************************************************************/
+/*!
+   @brief    Draw a RAM-resident 16-bit image (RGB 5/6/5) taken out of a wider one.
+   Row by row here, displays that can should send it as one address window.
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    bitmap  first pixel of the image
+   @param    w   Width of image in pixels
+   @param    h   Height of image in pixels
+   @param    stride  Pixels from the start of one row of bitmap to the next
+*/
+/**************************************************************************/
+void Arduino_G::draw16bitRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t stride)
+{
+  if (w == stride)
+  {
+    draw16bitRGBBitmap(x, y, bitmap, w, h);
+    return;
+  }
+  for (int16_t j = 0; j < h; j++)
+  {
+    draw16bitRGBBitmap(x, y + j, bitmap, w, 1);
+    bitmap += stride;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a RAM-resident 16-bit Big Endian image (RGB 5/6/5) taken out of a wider one.
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    bitmap  first pixel of the image
+   @param    w   Width of image in pixels
+   @param    h   Height of image in pixels
+   @param    stride  Pixels from the start of one row of bitmap to the next
+*/
+/**************************************************************************/
+void Arduino_G::draw16bitBeRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t stride)
+{
+  if (w == stride)
+  {
+    draw16bitBeRGBBitmap(x, y, bitmap, w, h);
+    return;
+  }
+  for (int16_t j = 0; j < h; j++)
+  {
+    draw16bitBeRGBBitmap(x, y + j, bitmap, w, 1);
+    bitmap += stride;
+  }
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+/**************************************************************************/
+/*!
+   @brief    Draw a RAM-resident 16-bit image (RGB 5/6/5) and call done(arg)
+   once the bitmap may be reused. Drawn before returning here, displays with
+   a DMA capable bus override it to run the transfer in the background.
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    bitmap  byte array with 16-bit color bitmap
+   @param    w   Width of bitmap in pixels
+   @param    h   Height of bitmap in pixels
+   @param    done  Called once the bitmap may be reused, can be NULL
+   @param    arg   Passed to done
+*/
+/**************************************************************************/
+void Arduino_G::draw16bitRGBBitmapAsync(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, gfx_async_done_cb_t done, void *arg)
+{
+  draw16bitRGBBitmap(x, y, bitmap, w, h);
+  if (done)
+  {
+    done(arg);
+  }
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+static void gfx_rects_union(gfx_rect_t *a, const gfx_rect_t *b)
+{
+  int16_t ux = (a->x < b->x) ? a->x : b->x;
+  int16_t uy = (a->y < b->y) ? a->y : b->y;
+  int16_t ux2 = ((a->x + a->w) > (b->x + b->w)) ? (a->x + a->w) : (b->x + b->w);
+  int16_t uy2 = ((a->y + a->h) > (b->y + b->h)) ? (a->y + a->h) : (b->y + b->h);
+  a->x = ux;
+  a->y = uy;
+  a->w = ux2 - ux;
+  a->h = uy2 - uy;
+}
+
+// pixels the union of a and b covers that neither of them does
+static int32_t gfx_rects_waste(const gfx_rect_t *a, const gfx_rect_t *b)
+{
+  gfx_rect_t u = *a;
+  gfx_rects_union(&u, b);
+  int16_t ix = ((a->x + a->w) < (b->x + b->w)) ? (a->x + a->w) : (b->x + b->w);
+  int16_t iy = ((a->y + a->h) < (b->y + b->h)) ? (a->y + a->h) : (b->y + b->h);
+  ix -= (a->x > b->x) ? a->x : b->x;
+  iy -= (a->y > b->y) ? a->y : b->y;
+  int32_t inter = ((ix > 0) && (iy > 0)) ? ((int32_t)ix * iy) : 0;
+  return (int32_t)u.w * u.h - (int32_t)a->w * a->h - (int32_t)b->w * b->h + inter;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Add a rectangle to a short list. Rectangles whose union wastes
+   at most GFX_RECT_MERGE_SLACK pixels are merged, a full list merges the
+   pair that wastes least.
+   @param    rects  the list
+   @param    count  rectangles in the list, updated
+   @param    max_rects  room in the list
+   @param    r  rectangle to add
+*/
+/**************************************************************************/
+void gfx_add_rect(gfx_rect_t *rects, uint8_t *count, uint8_t max_rects, const gfx_rect_t *r)
+{
+  if (!max_rects)
+  {
+    return; // no room, and nothing to merge into
+  }
+
+  gfx_rect_t u = *r;
+  int32_t waste, best_waste;
+  uint8_t best_i, best_j;
+  uint8_t i;
+
+  for (;;)
+  {
+    // take in everything close enough, the union may then reach further
+    i = 0;
+    while (i < *count)
+    {
+      if (gfx_rects_waste(&u, &rects[i]) <= GFX_RECT_MERGE_SLACK)
+      {
+        gfx_rects_union(&u, &rects[i]);
+        rects[i] = rects[--(*count)];
+        i = 0;
+      }
+      else
+      {
+        i++;
+      }
+    }
+
+    if (*count < max_rects)
+    {
+      rects[(*count)++] = u;
+      return;
+    }
+
+    // full: the cheapest pair among the list and u is merged, j == count stands for u
+    best_waste = INT32_MAX;
+    best_i = best_j = 0;
+    for (i = 0; i < *count; i++)
+    {
+      for (uint8_t j = i + 1; j <= *count; j++)
+      {
+        waste = gfx_rects_waste(&rects[i], (j == *count) ? &u : &rects[j]);
+        if (waste < best_waste)
+        {
+          best_waste = waste;
+          best_i = i;
+          best_j = j;
+        }
+      }
+    }
+    if (best_j == *count)
+    {
+      gfx_rects_union(&u, &rects[best_i]);
+    }
+    else
+    {
+      gfx_rects_union(&rects[best_j], &rects[best_i]);
+      gfx_rect_t merged = rects[best_j];
+      rects[best_j] = u;
+      u = merged;
+    }
+    rects[best_i] = rects[--(*count)];
+  }
+}
+
 #endif // !defined(LITTLE_FOOT_PRINT)
@@ -7,6 +7,18 @@
 
 #include "Arduino_DataBus.h"
 
+typedef struct
+{
+  int16_t x, y, w, h;
+} gfx_rect_t;
+
+#ifndef GFX_RECT_MERGE_SLACK
+#define GFX_RECT_MERGE_SLACK 32 // pixels of waste worth saving a separate rectangle
+#endif
+
+// Adds r to a list of at most max_rects rectangles, merging those close together
+void gfx_add_rect(gfx_rect_t *rects, uint8_t *count, uint8_t max_rects, const gfx_rect_t *r);
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a minimum you can subclass and provide drawPixel(). At a maximum you can do a ton of overriding to optimize. Used for any/all Adafruit displays!
 class Arduino_G
 {
@@ -20,7 +32,24 @@ public:
   virtual void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h) = 0;
   virtual void draw3bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) = 0;
   virtual void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) = 0;
+  virtual void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) = 0;
   virtual void draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) = 0;
+  virtual void draw16bitRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t stride);
+  virtual void draw16bitBeRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t stride);
+  // Arduino_DataBus.h has decided LITTLE_FOOT_PRINT by now, the guard at the top ran before it
+#if !defined(LITTLE_FOOT_PRINT)
+  virtual void draw16bitRGBBitmapAsync(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, gfx_async_done_cb_t done = NULL, void *arg = NULL);
+  virtual bool supportsAsync() { return false; } // draw16bitRGBBitmapAsync() returns before the transfer ends
+  virtual bool isAsyncBusy() { return false; } // also polls for the end of the transfer
+  virtual void waitAsync() {}
+  // True when a bitmap in this byte order goes to the panel straight from memory, see Arduino_DataBus
+  virtual bool supportsZeroCopy(const void *data, bool big_endian)
+  {
+    UNUSED(data);
+    UNUSED(big_endian);
+    return false;
+  }
+#endif // !defined(LITTLE_FOOT_PRINT)
 
 protected:
   int16_t
@@ -38,6 +38,7 @@ Arduino_GFX::Arduino_GFX(int16_t w, int16_t h) : Arduino_G(w, h)
   text_pixel_margin = 0;
   textcolor = textbgcolor = 0xFFFF;
   wrap = true;
+  _blend_lut_valid = false;
 #if !defined(ATTINY_CORE)
   gfxFont = NULL;
 #if defined(U8G2_FONT_SUPPORT)
@@ -131,6 +132,107 @@ void Arduino_GFX::writeSlashLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
   }
 }
 
+/**************************************************************************/
+/*!
+  @brief  Write an anti-aliased line. Xiaolin Wu's algorithm in 16.16 fixed point,
+          each step covers the pixel on the ideal line and its neighbour below it.
+          Coverage is blended against a known background color through a cached
+          lookup table, so no pixels are read back from the display.
+  @param  x0      Start point x coordinate
+  @param  y0      Start point y coordinate
+  @param  x1      End point x coordinate
+  @param  y1      End point y coordinate
+  @param  color   16-bit 5-6-5 Color to draw with
+  @param  bg      16-bit 5-6-5 Color of the background the line is drawn over
+*/
+/**************************************************************************/
+void Arduino_GFX::writeAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                       uint16_t color, uint16_t bg)
+{
+  if ((x0 == x1) || (y0 == y1))
+  {
+    // straight lines have full coverage everywhere
+    writeLine(x0, y0, x1, y1, color);
+    return;
+  }
+
+  bool steep = _diff(y1, y0) > _diff(x1, x0);
+  if (steep)
+  {
+    _swap_int16_t(x0, y0);
+    _swap_int16_t(x1, y1);
+  }
+
+  if (x0 > x1)
+  {
+    _swap_int16_t(x0, x1);
+    _swap_int16_t(y0, y1);
+  }
+
+  uint16_t *lut = blendLut(color, bg);
+  int16_t dx = x1 - x0;
+  int32_t dy = (int32_t)(y1 - y0) << 16;
+  int32_t gradient = (dy + ((dy < 0) ? -(dx >> 1) : (dx >> 1))) / dx;
+  int32_t intery = (int32_t)y0 << 16;
+  int16_t y;
+  uint8_t frac;
+
+  for (; x0 <= x1; x0++)
+  {
+    y = intery >> 16;
+    frac = (intery >> (16 - AA_COVERAGE_BITS)) & AA_COVERAGE_MAX;
+    if (steep)
+    {
+      writePixel(y, x0, lut[AA_COVERAGE_MAX - frac]);
+      if (frac)
+      {
+        writePixel(y + 1, x0, lut[frac]);
+      }
+    }
+    else
+    {
+      writePixel(x0, y, lut[AA_COVERAGE_MAX - frac]);
+      if (frac)
+      {
+        writePixel(x0, y + 1, lut[frac]);
+      }
+    }
+    intery += gradient;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Get the color over background blend table, rebuilt only when the
+          color pair differs from the previous call.
+  @param  color   16-bit 5-6-5 foreground color (full coverage)
+  @param  bg      16-bit 5-6-5 background color (zero coverage)
+  @return AA_COVERAGE_LEVELS entries indexed by coverage
+*/
+/**************************************************************************/
+uint16_t *Arduino_GFX::blendLut(uint16_t color, uint16_t bg)
+{
+  if ((!_blend_lut_valid) || (color != _blend_color) || (bg != _blend_bg))
+  {
+    int16_t r = bg >> 11;
+    int16_t g = (bg >> 5) & 0x3F;
+    int16_t b = bg & 0x1F;
+    int16_t dr = (color >> 11) - r;
+    int16_t dg = ((color >> 5) & 0x3F) - g;
+    int16_t db = (color & 0x1F) - b;
+    for (int16_t a = 0; a < AA_COVERAGE_LEVELS; a++)
+    {
+      _blend_lut[a] = ((r + (dr * a) / AA_COVERAGE_MAX) << 11) |
+                      ((g + (dg * a) / AA_COVERAGE_MAX) << 5) |
+                      (b + (db * a) / AA_COVERAGE_MAX);
+    }
+    _blend_color = color;
+    _blend_bg = bg;
+    _blend_lut_valid = true;
+  }
+  return _blend_lut;
+}
+
 /**************************************************************************/
 /*!
   @brief  Start a display-writing routine, overwrite in subclasses.
@@ -382,6 +484,363 @@ void Arduino_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
   endWrite();
 }
 
+/**************************************************************************/
+/*!
+  @brief  Draw an anti-aliased line over a known background color
+  @param  x0      Start point x coordinate
+  @param  y0      Start point y coordinate
+  @param  x1      End point x coordinate
+  @param  y1      End point y coordinate
+  @param  color   16-bit 5-6-5 Color to draw with
+  @param  bg      16-bit 5-6-5 Color of the background the line is drawn over
+*/
+/**************************************************************************/
+void Arduino_GFX::drawAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                      uint16_t color, uint16_t bg)
+{
+  startWrite();
+  writeAntialiasedLine(x0, y0, x1, y1, color, bg);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Compute the corners of a thick line, as a quad in fixed point
+          with THICK_LINE_FRAC_BITS sub-pixel bits. The line is extended by
+          half a pixel past each end point so end pixels are fully covered.
+  @param  x0      Start point x coordinate
+  @param  y0      Start point y coordinate
+  @param  x1      End point x coordinate
+  @param  y1      End point y coordinate
+  @param  width   Line width in pixels
+  @param  qx      4 corner x coordinates, in order around the quad
+  @param  qy      4 corner y coordinates, in order around the quad
+*/
+/**************************************************************************/
+void Arduino_GFX::thickLineQuad(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                uint8_t width, int16_t *qx, int16_t *qy)
+{
+  int32_t dx = x1 - x0;
+  int32_t dy = y1 - y0;
+  int32_t ux, uy, nx, ny;
+
+  // line length with 4 fractional bits: isqrt((dx^2 + dy^2) << 8)
+  uint32_t n = (uint32_t)(dx * dx + dy * dy) << 8;
+  uint32_t len = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > n)
+  {
+    bit >>= 2;
+  }
+  while (bit)
+  {
+    if (n >= len + bit)
+    {
+      n -= len + bit;
+      len = (len >> 1) + bit;
+    }
+    else
+    {
+      len >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  if (len == 0)
+  {
+    // single point, draw a width square
+    ux = 1 << (THICK_LINE_FRAC_BITS - 1);
+    uy = 0;
+    nx = 0;
+    ny = (int32_t)width << (THICK_LINE_FRAC_BITS - 1);
+  }
+  else
+  {
+    // half a pixel along the line and half the width across it
+    ux = dx * (1 << (THICK_LINE_FRAC_BITS + 3)) / (int32_t)len;
+    uy = dy * (1 << (THICK_LINE_FRAC_BITS + 3)) / (int32_t)len;
+    nx = -dy * width * (1 << (THICK_LINE_FRAC_BITS + 3)) / (int32_t)len;
+    ny = dx * width * (1 << (THICK_LINE_FRAC_BITS + 3)) / (int32_t)len;
+  }
+
+  int32_t px0 = (int32_t)x0 << THICK_LINE_FRAC_BITS;
+  int32_t py0 = (int32_t)y0 << THICK_LINE_FRAC_BITS;
+  int32_t px1 = (int32_t)x1 << THICK_LINE_FRAC_BITS;
+  int32_t py1 = (int32_t)y1 << THICK_LINE_FRAC_BITS;
+  qx[0] = px0 - ux + nx;
+  qy[0] = py0 - uy + ny;
+  qx[1] = px1 + ux + nx;
+  qy[1] = py1 + uy + ny;
+  qx[2] = px1 + ux - nx;
+  qy[2] = py1 + uy - ny;
+  qx[3] = px0 - ux - nx;
+  qy[3] = py0 - uy - ny;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Scan-convert one row of a thick line quad. Pixels whose centres
+          fall inside the quad are covered, rows the quad only grazes get
+          the single pixel nearest its middle so steep thin lines stay
+          connected.
+  @param  qx      4 corner x coordinates from thickLineQuad()
+  @param  qy      4 corner y coordinates from thickLineQuad()
+  @param  y       Row to convert
+  @param  xl      Returns the first covered pixel
+  @param  xr      Returns the last covered pixel
+  @return true if the row crosses the quad
+*/
+/**************************************************************************/
+bool Arduino_GFX::thickLineSpan(const int16_t *qx, const int16_t *qy, int16_t y,
+                                int16_t *xl, int16_t *xr)
+{
+  int32_t yc = (int32_t)y << THICK_LINE_FRAC_BITS;
+  int32_t xmin = INT32_MAX;
+  int32_t xmax = INT32_MIN;
+  int32_t x;
+  uint8_t j = 3;
+
+  for (uint8_t i = 0; i < 4; j = i++)
+  {
+    int32_t ya = qy[j], yb = qy[i];
+    // half-open edges, so horizontal edges and the bottom vertex are skipped
+    if (((ya <= yc) && (yc < yb)) || ((yb <= yc) && (yc < ya)))
+    {
+      x = qx[j] + (((int32_t)qx[i] - qx[j]) * (yc - ya)) / (yb - ya);
+      if (x < xmin)
+      {
+        xmin = x;
+      }
+      if (x > xmax)
+      {
+        xmax = x;
+      }
+    }
+  }
+
+  if (xmin > xmax)
+  {
+    return false;
+  }
+
+  // round pixel centres inwards: [ceil(xmin), ceil(xmax) - 1]
+  const int32_t round_up = (1 << THICK_LINE_FRAC_BITS) - 1;
+  *xl = (xmin + round_up) >> THICK_LINE_FRAC_BITS;
+  *xr = ((xmax + round_up) >> THICK_LINE_FRAC_BITS) - 1;
+  if (*xr < *xl)
+  {
+    *xl = *xr = (xmin + xmax + (1 << THICK_LINE_FRAC_BITS)) >> (THICK_LINE_FRAC_BITS + 1);
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a line of any width. The line is scan-converted to one
+          horizontal span per row, and runs of rows with identical spans
+          are filled as a single rectangle so straight and near straight
+          lines need only a few address windows.
+  @param  x0      Start point x coordinate
+  @param  y0      Start point y coordinate
+  @param  x1      End point x coordinate
+  @param  y1      End point y coordinate
+  @param  width   Line width in pixels
+  @param  color   16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Arduino_GFX::drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                uint8_t width, uint16_t color)
+{
+  if (width <= 1)
+  {
+    drawLine(x0, y0, x1, y1, color);
+    return;
+  }
+
+  int16_t qx[4], qy[4];
+  thickLineQuad(x0, y0, x1, y1, width, qx, qy);
+
+  int16_t ymin = qy[0], ymax = qy[0];
+  for (uint8_t i = 1; i < 4; i++)
+  {
+    if (qy[i] < ymin)
+    {
+      ymin = qy[i];
+    }
+    if (qy[i] > ymax)
+    {
+      ymax = qy[i];
+    }
+  }
+  const int16_t round_up = (1 << THICK_LINE_FRAC_BITS) - 1;
+  ymin = (ymin + round_up) >> THICK_LINE_FRAC_BITS;
+  ymax = ((ymax + round_up) >> THICK_LINE_FRAC_BITS) - 1;
+  if (ymin < 0)
+  {
+    ymin = 0;
+  }
+  if (ymax > _max_y)
+  {
+    ymax = _max_y;
+  }
+
+  // pending rectangle of rows sharing the same span
+  int16_t px = 0, pw = 0, py = 0, ph = 0;
+  int16_t xl, xr;
+
+  startWrite();
+  for (int16_t y = ymin; y <= ymax; y++)
+  {
+    if (!thickLineSpan(qx, qy, y, &xl, &xr))
+    {
+      continue;
+    }
+    if ((ph > 0) && (xl == px) && (xr - xl + 1 == pw) && (py + ph == y))
+    {
+      ph++;
+    }
+    else
+    {
+      if (ph > 0)
+      {
+        writeFillRect(px, py, pw, ph, color);
+      }
+      px = xl;
+      pw = xr - xl + 1;
+      py = y;
+      ph = 1;
+    }
+  }
+  if (ph > 0)
+  {
+    writeFillRect(px, py, pw, ph, color);
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Move a thick line from one position to another. Only the pixels
+          of the old line that the new line does not cover are erased, so
+          a small change of angle costs a few pixels per row instead of a
+          full erase and redraw.
+  @param  ox0     Old start point x coordinate
+  @param  oy0     Old start point y coordinate
+  @param  ox1     Old end point x coordinate
+  @param  oy1     Old end point y coordinate
+  @param  x0      New start point x coordinate
+  @param  y0      New start point y coordinate
+  @param  x1      New end point x coordinate
+  @param  y1      New end point y coordinate
+  @param  width   Line width in pixels, the same for both lines
+  @param  color   16-bit 5-6-5 Color to draw with
+  @param  bg      16-bit 5-6-5 Color to erase with
+*/
+/**************************************************************************/
+void Arduino_GFX::moveThickLine(int16_t ox0, int16_t oy0, int16_t ox1, int16_t oy1,
+                                int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                uint8_t width, uint16_t color, uint16_t bg)
+{
+  if (width <= 1)
+  {
+    startWrite();
+    writeLine(ox0, oy0, ox1, oy1, bg);
+    writeLine(x0, y0, x1, y1, color);
+    endWrite();
+    return;
+  }
+
+  int16_t oqx[4], oqy[4], qx[4], qy[4];
+  thickLineQuad(ox0, oy0, ox1, oy1, width, oqx, oqy);
+  thickLineQuad(x0, y0, x1, y1, width, qx, qy);
+
+  int16_t ymin = qy[0], ymax = qy[0];
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    if (qy[i] < ymin)
+    {
+      ymin = qy[i];
+    }
+    if (qy[i] > ymax)
+    {
+      ymax = qy[i];
+    }
+    if (oqy[i] < ymin)
+    {
+      ymin = oqy[i];
+    }
+    if (oqy[i] > ymax)
+    {
+      ymax = oqy[i];
+    }
+  }
+  const int16_t round_up = (1 << THICK_LINE_FRAC_BITS) - 1;
+  ymin = (ymin + round_up) >> THICK_LINE_FRAC_BITS;
+  ymax = ((ymax + round_up) >> THICK_LINE_FRAC_BITS) - 1;
+  if (ymin < 0)
+  {
+    ymin = 0;
+  }
+  if (ymax > _max_y)
+  {
+    ymax = _max_y;
+  }
+
+  int16_t px = 0, pw = 0, py = 0, ph = 0;
+  int16_t oxl, oxr, xl, xr;
+  bool old_row, new_row;
+
+  startWrite();
+  for (int16_t y = ymin; y <= ymax; y++)
+  {
+    old_row = thickLineSpan(oqx, oqy, y, &oxl, &oxr);
+    new_row = thickLineSpan(qx, qy, y, &xl, &xr);
+    if (old_row)
+    {
+      if (!new_row)
+      {
+        writeFastHLine(oxl, y, oxr - oxl + 1, bg);
+      }
+      else
+      {
+        if (oxl < xl)
+        {
+          writeFastHLine(oxl, y, ((oxr < xl) ? oxr : (xl - 1)) - oxl + 1, bg);
+        }
+        if (oxr > xr)
+        {
+          int16_t ex = (oxl > xr) ? oxl : (xr + 1);
+          writeFastHLine(ex, y, oxr - ex + 1, bg);
+        }
+      }
+    }
+    if (!new_row)
+    {
+      continue;
+    }
+    if ((ph > 0) && (xl == px) && (xr - xl + 1 == pw) && (py + ph == y))
+    {
+      ph++;
+    }
+    else
+    {
+      if (ph > 0)
+      {
+        writeFillRect(px, py, pw, ph, color);
+      }
+      px = xl;
+      pw = xr - xl + 1;
+      py = y;
+      ph = 1;
+    }
+  }
+  if (ph > 0)
+  {
+    writeFillRect(px, py, pw, ph, color);
+  }
+  endWrite();
+}
+
 /**************************************************************************/
 /*!
   @brief  Draw a circle outline
@@ -48,6 +48,9 @@
 #define GREENYELLOW 0xAFE5 ///< 173, 255,  41
 #define PINK 0xFC18        ///< 255, 130, 198
 
+// Color constant in big-endian byte order, for writing straight into a big-endian canvas framebuffer
+#define BE_COLOR(c) ((uint16_t)((((c)&0xFF) << 8) | (((c) >> 8) & 0xFF)))
+
 // Many (but maybe not all) non-AVR board installs define macros
 // for compatibility with existing PROGMEM-reading AVR code.
 // Do our own checks and defines here for good measure...
@@ -106,6 +109,20 @@
 #define _in_range(v, a, b) ((a > b) ? _ordered_in_range(v, b, a) : _ordered_in_range(v, a, b))
 #endif
 
+// Anti-aliased line coverage resolution, blend table has 1 << AA_COVERAGE_BITS entries
+#ifndef AA_COVERAGE_BITS
+#if defined(LITTLE_FOOT_PRINT)
+#define AA_COVERAGE_BITS 4
+#else
+#define AA_COVERAGE_BITS 5
+#endif
+#endif
+#define AA_COVERAGE_LEVELS (1 << AA_COVERAGE_BITS)
+#define AA_COVERAGE_MAX (AA_COVERAGE_LEVELS - 1)
+
+// Thick line quad corners are kept in fixed point with THICK_LINE_FRAC_BITS sub-pixel bits
+#define THICK_LINE_FRAC_BITS 4
+
 #if !defined(ATTINY_CORE)
 INLINE GFXglyph *pgm_read_glyph_ptr(const GFXfont *gfxFont, uint8_t c)
 {
@@ -146,6 +163,12 @@ public:
   virtual void begin(int32_t speed = GFX_NOT_DEFINED) = 0;
   virtual void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) = 0;
 
+#if !defined(LITTLE_FOOT_PRINT)
+  // Non-blocking begin(): start it, do other setup work, then call beginPoll() until it returns true
+  virtual void beginAsync(int32_t speed = GFX_NOT_DEFINED) { begin(speed); }
+  virtual bool beginPoll() { return true; }
+#endif // !defined(LITTLE_FOOT_PRINT)
+
   // TRANSACTION API / CORE DRAW API
   // These MAY be overridden by the subclass to provide device-specific
   // optimized code.  Otherwise 'generic' versions are used.
@@ -176,6 +199,10 @@ public:
   void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   void fillScreen(uint16_t color);
   void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void drawAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint16_t bg);
+  void drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t width, uint16_t color);
+  void moveThickLine(int16_t ox0, int16_t oy0, int16_t ox1, int16_t oy1,
+                     int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t width, uint16_t color, uint16_t bg);
   void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
   void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
@@ -223,6 +250,7 @@ public:
 // TFT optimization code, too big for ATMEL family
 #if defined(LITTLE_FOOT_PRINT)
   void writeSlashLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void writeAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint16_t bg);
   void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg);
   void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg);
   void drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h);
@@ -238,6 +266,7 @@ public:
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg);
 #else  // !defined(LITTLE_FOOT_PRINT)
   virtual void writeSlashLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  virtual void writeAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint16_t bg);
   virtual void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg);
   virtual void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg);
   virtual void drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h);
@@ -358,6 +387,9 @@ public:
   }
 
 protected:
+  uint16_t *blendLut(uint16_t color, uint16_t bg);
+  void thickLineQuad(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t width, int16_t *qx, int16_t *qy);
+  bool thickLineSpan(const int16_t *qx, const int16_t *qy, int16_t y, int16_t *xl, int16_t *xr);
   void charBounds(char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy);
   int16_t
       _width,   ///< Display width as modified by current rotation
@@ -376,6 +408,12 @@ protected:
       _rotation;         ///< Display rotation (0 thru 3)
   bool
       wrap; ///< If set, 'wrap' text at right edge of display
+  uint16_t
+      _blend_lut[AA_COVERAGE_LEVELS], ///< Cached color over bg blend per coverage level
+      _blend_color,                   ///< Foreground color of cached blend table
+      _blend_bg;                      ///< Background color of cached blend table
+  bool
+      _blend_lut_valid; ///< Blend table has been built for _blend_color/_blend_bg
 #if !defined(ATTINY_CORE)
   GFXfont *gfxFont; ///< Pointer to special font
 #endif              // !defined(ATTINY_CORE)
@@ -0,0 +1,180 @@
+/*
+ * Placement of graphics buffers: one arena per memory region, or the heap
+ */
+#include "Arduino_GFX_Alloc.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+#if defined(ESP32)
+#include "esp_heap_caps.h"
+#endif
+
+typedef struct
+{
+  uint8_t *base;
+  size_t size;
+  size_t used;
+  size_t high_water;
+  uint8_t *last; // latest buffer, the one gfx_free() can give back
+} gfx_arena_t;
+
+// Ahead of every heap buffer, so gfx_free() knows what to take off `used`.
+// A multiple of size_t, the buffer behind it stays 4-byte aligned.
+typedef struct
+{
+  size_t size;
+  size_t mem;
+} gfx_heap_header_t;
+
+static gfx_arena_t gfx_arenas[GFX_MEM_REGIONS];
+
+static void *gfx_heap_alloc(size_t size, uint8_t mem)
+{
+#if defined(ESP32)
+  if (mem == GFX_MEM_INTERNAL)
+  {
+    return heap_caps_malloc(size, MALLOC_CAP_DMA);
+  }
+  if (psramFound())
+  {
+    return ps_malloc(size);
+  }
+#else
+  UNUSED(mem);
+#endif
+  return malloc(size);
+}
+
+bool gfx_arena_begin(size_t internal_size, size_t large_size)
+{
+  size_t sizes[GFX_MEM_REGIONS] = {internal_size, large_size};
+  bool ok = true;
+  for (uint8_t mem = 0; mem < GFX_MEM_REGIONS; mem++)
+  {
+    gfx_arena_t *a = &gfx_arenas[mem];
+    if ((a->base) || (!sizes[mem]))
+    {
+      continue;
+    }
+    size_t size = (sizes[mem] + 3) & ~3;
+    a->base = (uint8_t *)gfx_heap_alloc(size, mem);
+    if (!a->base)
+    {
+      Serial.print(F("gfx arena allocation failed: "));
+      Serial.println(size);
+      ok = false;
+      continue;
+    }
+    a->size = size;
+    a->used = 0;
+    a->high_water = 0;
+    a->last = NULL;
+  }
+  return ok;
+}
+
+void *gfx_alloc(size_t size, uint8_t mem)
+{
+  if (mem >= GFX_MEM_REGIONS)
+  {
+    mem = GFX_MEM_LARGE;
+  }
+  gfx_arena_t *a = &gfx_arenas[mem];
+  // 4-byte aligned for DMA and 32-bit access
+  size = (size + 3) & ~3;
+  if (!a->base)
+  {
+    gfx_heap_header_t *h = (gfx_heap_header_t *)gfx_heap_alloc(sizeof(gfx_heap_header_t) + size, mem);
+    if (!h)
+    {
+      return NULL;
+    }
+    h->size = size;
+    h->mem = mem;
+    a->used += size;
+    if (a->used > a->high_water)
+    {
+      a->high_water = a->used;
+    }
+    return h + 1;
+  }
+  if (size > (a->size - a->used))
+  {
+    Serial.print(F("gfx arena full, needed: "));
+    Serial.println(size);
+    return NULL;
+  }
+  a->last = a->base + a->used;
+  a->used += size;
+  if (a->used > a->high_water)
+  {
+    a->high_water = a->used;
+  }
+  return a->last;
+}
+
+void gfx_free(void *p)
+{
+  if (!p)
+  {
+    return;
+  }
+  for (uint8_t mem = 0; mem < GFX_MEM_REGIONS; mem++)
+  {
+    gfx_arena_t *a = &gfx_arenas[mem];
+    if ((a->base) && ((uint8_t *)p >= a->base) && ((uint8_t *)p < (a->base + a->size)))
+    {
+      if (p == a->last)
+      {
+        a->used = a->last - a->base;
+        a->last = NULL;
+      }
+      else
+      {
+        // an arena only shrinks from the top, this buffer stays taken
+        Serial.println(F("gfx_free: not the latest arena buffer, kept"));
+      }
+      return;
+    }
+  }
+  gfx_heap_header_t *h = (gfx_heap_header_t *)p - 1;
+  gfx_arenas[h->mem].used -= h->size;
+  free(h);
+}
+
+size_t gfx_arena_used(uint8_t mem)
+{
+  return (mem < GFX_MEM_REGIONS) ? gfx_arenas[mem].used : 0;
+}
+
+size_t gfx_arena_high_water(uint8_t mem)
+{
+  return (mem < GFX_MEM_REGIONS) ? gfx_arenas[mem].high_water : 0;
+}
+
+size_t gfx_arena_size(uint8_t mem)
+{
+  return (mem < GFX_MEM_REGIONS) ? gfx_arenas[mem].size : 0;
+}
+
+void gfx_arena_print()
+{
+  for (uint8_t mem = 0; mem < GFX_MEM_REGIONS; mem++)
+  {
+    gfx_arena_t *a = &gfx_arenas[mem];
+    Serial.print((mem == GFX_MEM_INTERNAL) ? F("gfx internal: ") : F("gfx large: "));
+    Serial.print(a->used);
+    Serial.print(F(" used, "));
+    Serial.print(a->high_water);
+    Serial.print(F(" high water, "));
+    if (a->base)
+    {
+      Serial.print(a->size);
+      Serial.println(F(" arena"));
+    }
+    else
+    {
+      Serial.println(F("heap"));
+    }
+  }
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,28 @@
+/*
+ * Placement of graphics buffers: one arena per memory region, or the heap
+ */
+#ifndef _ARDUINO_GFX_ALLOC_H_
+#define _ARDUINO_GFX_ALLOC_H_
+
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+// Where gfx_alloc() places a buffer
+#define GFX_MEM_INTERNAL 0 // internal RAM, DMA capable on ESP32
+#define GFX_MEM_LARGE 1    // PSRAM when the board has it, internal RAM otherwise
+#define GFX_MEM_REGIONS 2
+
+// Graphics buffers come out of one arena per region, reserved by
+// gfx_arena_begin() early in setup(), so nothing is taken from the heap once
+// drawing starts. Without it gfx_alloc() falls back to the heap with the same
+// placement.
+bool gfx_arena_begin(size_t internal_size, size_t large_size = 0);
+void *gfx_alloc(size_t size, uint8_t mem = GFX_MEM_LARGE);
+void gfx_free(void *p); // only the latest arena buffer is given back
+size_t gfx_arena_used(uint8_t mem); // from the heap this counts the buffers still held
+size_t gfx_arena_high_water(uint8_t mem);
+size_t gfx_arena_size(uint8_t mem); // 0 when the region is served from the heap
+void gfx_arena_print();
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+#endif // _ARDUINO_GFX_ALLOC_H_
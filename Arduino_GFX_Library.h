@@ -2,7 +2,11 @@
 #define _ARDUINO_GFX_LIBRARIES_H_
 
 #include "Arduino_DataBus.h"
+#include "Arduino_GFX_Alloc.h"
 #include "databus/Arduino_AVRPAR8.h"
+#include "databus/Arduino_BatchBus.h"
+#include "databus/Arduino_BusBenchmark.h"
+#include "databus/Arduino_BusRecorder.h"
 #include "databus/Arduino_ESP32LCD8.h"
 #include "databus/Arduino_ESP32LCD16.h"
 #include "databus/Arduino_ESP32PAR8.h"
@@ -16,6 +20,7 @@
 #include "databus/Arduino_ESP32S2PAR8Q.h"
 #include "databus/Arduino_ESP32S2PAR16.h"
 #include "databus/Arduino_ESP32S2PAR16Q.h"
+#include "databus/Arduino_DMASPI.h"
 #include "databus/Arduino_ESP32SPI.h"
 #include "databus/Arduino_ESP8266SPI.h"
 #include "databus/Arduino_HWSPI.h"
@@ -25,6 +30,7 @@
 #include "databus/Arduino_RPiPicoPAR16.h"
 #include "databus/Arduino_RPiPicoSPI.h"
 #include "databus/Arduino_RTLPAR8.h"
+#include "databus/Arduino_SPIBusManager.h"
 #include "databus/Arduino_STM32PAR8.h"
 #include "databus/Arduino_SWPAR8.h"
 #include "databus/Arduino_SWSPI.h"
@@ -32,11 +38,18 @@
 #include "Arduino_GFX.h" // Core graphics library
 #if !defined(LITTLE_FOOT_PRINT)
 #include "canvas/Arduino_Canvas.h"
+#include "canvas/Arduino_Canvas_DoubleBuffer.h"
 #include "canvas/Arduino_Canvas_Indexed.h"
 #include "canvas/Arduino_Canvas_3bit.h"
 #include "canvas/Arduino_Canvas_Mono.h"
+#include "canvas/Arduino_Canvas_Window.h"
+#include "canvas/Arduino_Canvas_Strip.h"
+#include "canvas/Arduino_DisplayList.h"
+#include "canvas/Arduino_SaveUnder.h"
+#include "canvas/Arduino_SpriteLayer.h"
 #include "display/Arduino_ILI9488_3bit.h"
 #endif // !defined(LITTLE_FOOT_PRINT)
+#include "canvas/Arduino_Canvas_RLE.h"
 
 #include "display/Arduino_GC9106.h"
 #include "display/Arduino_GC9107.h"
@@ -20,6 +20,7 @@ Arduino_TFT::Arduino_TFT(
 
 void Arduino_TFT::begin(int32_t speed)
 {
+#if defined(LITTLE_FOOT_PRINT)
   if (_override_datamode != GFX_NOT_DEFINED)
   {
     _bus->begin(speed, _override_datamode);
@@ -32,7 +33,66 @@ void Arduino_TFT::begin(int32_t speed)
   tftInit();
   setRotation(_rotation); // apply the setting rotation to the display
   setAddrWindow(0, 0, _width, _height);
+#else  // !defined(LITTLE_FOOT_PRINT)
+  beginAsync(speed);
+  while (!beginPoll())
+  {
+    delay(1);
+  }
+#endif // !defined(LITTLE_FOOT_PRINT)
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+void Arduino_TFT::beginAsync(int32_t speed)
+{
+  if (_override_datamode != GFX_NOT_DEFINED)
+  {
+    _bus->begin(speed, _override_datamode);
+  }
+  else
+  {
+    _bus->begin(speed);
+  }
+
+  _init_pending = true;
+  _init_wait_ms = 0;
+  tftInitStart();
+}
+
+bool Arduino_TFT::beginPoll()
+{
+  if (!_init_pending)
+  {
+    return true;
+  }
+  if (initWaiting() || (!tftInitPoll()))
+  {
+    return false;
+  }
+
+  _init_pending = false;
+  setRotation(_rotation); // apply the setting rotation to the display
+  setAddrWindow(0, 0, _width, _height);
+  return true;
+}
+
+// start a pause in the init sequence, the next tftInitPoll() comes after it
+void Arduino_TFT::initWait(uint16_t ms)
+{
+  _init_wait_ms = ms;
+  _init_wait_start = millis();
+}
+
+bool Arduino_TFT::initWaiting()
+{
+  if (_init_wait_ms && ((millis() - _init_wait_start) < _init_wait_ms))
+  {
+    return true;
+  }
+  _init_wait_ms = 0;
+  return false;
 }
+#endif // !defined(LITTLE_FOOT_PRINT)
 
 void Arduino_TFT::startWrite()
 {
@@ -309,6 +369,118 @@ void Arduino_TFT::writeSlashLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Write an anti-aliased line. Same Wu stepping as Arduino_GFX, but
+             batched like writeSlashLine: consecutive pixels on the same major
+             row are packed into one span for the line and one span for the
+             neighbour below it, each sent as a single address window.
+    @param    x0  Start point x coordinate
+    @param    y0  Start point y coordinate
+    @param    x1  End point x coordinate
+    @param    y1  End point y coordinate
+    @param    color 16-bit 5-6-5 Color to draw with
+    @param    bg 16-bit 5-6-5 Color of the background the line is drawn over
+*/
+/**************************************************************************/
+void Arduino_TFT::writeAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                       uint16_t color, uint16_t bg)
+{
+  if ((x0 == x1) || (y0 == y1))
+  {
+    writeLine(x0, y0, x1, y1, color);
+    return;
+  }
+
+  bool steep = _diff(y1, y0) > _diff(x1, x0);
+  if (steep)
+  {
+    _swap_int16_t(x0, y0);
+    _swap_int16_t(x1, y1);
+  }
+
+  if (x0 > x1)
+  {
+    _swap_int16_t(x0, x1);
+    _swap_int16_t(y0, y1);
+  }
+
+  // spans are not clipped, leave partly offscreen lines to the per pixel version
+  int16_t max_major = steep ? _max_y : _max_x;
+  int16_t max_minor = steep ? _max_x : _max_y;
+  if ((x0 < 0) || (x1 > max_major) || (y0 < 0) || (y1 < 0) || (y0 >= max_minor) || (y1 >= max_minor))
+  {
+    if (steep)
+    {
+      Arduino_GFX::writeAntialiasedLine(y0, x0, y1, x1, color, bg);
+    }
+    else
+    {
+      Arduino_GFX::writeAntialiasedLine(x0, y0, x1, y1, color, bg);
+    }
+    return;
+  }
+
+  uint16_t *lut = blendLut(color, bg);
+  uint16_t hi[AA_SPAN_PIXELS];
+  uint16_t lo[AA_SPAN_PIXELS];
+  int16_t dx = x1 - x0;
+  int32_t dy = (int32_t)(y1 - y0) << 16;
+  int32_t gradient = (dy + ((dy < 0) ? -(dx >> 1) : (dx >> 1))) / dx;
+  int32_t intery = (int32_t)y0 << 16;
+  int16_t xs = x0;
+  int16_t ys = y0;
+  int16_t len = 0;
+  int16_t lo_first = -1; // covered part of the lower span, zero coverage
+  int16_t lo_last = 0;   // only ever occurs at either end of a span
+  uint8_t frac;
+
+  while (x0 <= x1)
+  {
+    frac = (intery >> (16 - AA_COVERAGE_BITS)) & AA_COVERAGE_MAX;
+    hi[len] = lut[AA_COVERAGE_MAX - frac];
+    lo[len] = lut[frac];
+    if (frac)
+    {
+      if (lo_first < 0)
+      {
+        lo_first = len;
+      }
+      lo_last = len;
+    }
+    len++;
+    x0++;
+    intery += gradient;
+    if (((intery >> 16) != ys) || (len == AA_SPAN_PIXELS) || (x0 > x1))
+    {
+      if (steep)
+      {
+        writeAddrWindow(ys, xs, 1, len);
+        writePixels(hi, len);
+        if (lo_first >= 0)
+        {
+          writeAddrWindow(ys + 1, xs + lo_first, 1, lo_last - lo_first + 1);
+          writePixels(lo + lo_first, lo_last - lo_first + 1);
+        }
+      }
+      else
+      {
+        writeAddrWindow(xs, ys, len, 1);
+        writePixels(hi, len);
+        if (lo_first >= 0)
+        {
+          writeAddrWindow(xs + lo_first, ys + 1, lo_last - lo_first + 1, 1);
+          writePixels(lo + lo_first, lo_last - lo_first + 1);
+        }
+      }
+      len = 0;
+      lo_first = -1;
+      xs = x0;
+      ys = intery >> 16;
+    }
+  }
+}
+
 // TFT tuned BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
 
 /**************************************************************************/
@@ -748,6 +920,47 @@ void Arduino_TFT::draw16bitRGBBitmap(int16_t x, int16_t y,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 16-bit image (RGB 5/6/5) without waiting for
+   the transfer when the bus can run it in the background. The bitmap must
+   stay untouched until done(arg) has been called.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with 16-bit color bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    done  Called once the bitmap may be reused, can be NULL
+    @param    arg   Passed to done
+*/
+/**************************************************************************/
+void Arduino_TFT::draw16bitRGBBitmapAsync(int16_t x, int16_t y,
+                                          uint16_t *bitmap, int16_t w, int16_t h,
+                                          gfx_async_done_cb_t done, void *arg)
+{
+  if (
+      (!_bus->supportsAsync()) ||
+      (x < 0) ||                // Clip left
+      (y < 0) ||                // Clip top
+      ((x + w - 1) > _max_x) || // Clip right
+      ((y + h - 1) > _max_y)    // Clip bottom
+  )
+  {
+    draw16bitRGBBitmap(x, y, bitmap, w, h);
+    if (done)
+    {
+      done(arg);
+    }
+  }
+  else
+  {
+    startWrite();
+    writeAddrWindow(x, y, w, h);
+    _bus->writePixelsAsync(bitmap, (uint32_t)w * h, done, arg);
+    endWrite();
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief   Draw a RAM-resident 16-bit Big Endian image (RGB 5/6/5) at the specified (x,y) position.
@@ -789,6 +1002,82 @@ void Arduino_TFT::draw16bitBeRGBBitmap(int16_t x, int16_t y,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 16-bit image (RGB 5/6/5) taken out of a wider
+   one, as a single address window.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  first pixel of the image
+    @param    w   Width of image in pixels
+    @param    h   Height of image in pixels
+    @param    stride  Pixels from the start of one row of bitmap to the next
+*/
+/**************************************************************************/
+void Arduino_TFT::draw16bitRGBBitmapStride(int16_t x, int16_t y,
+                                           uint16_t *bitmap, int16_t w, int16_t h, int16_t stride)
+{
+  if (
+      (w == stride) ||          // One run
+      (x < 0) ||                // Clip left
+      (y < 0) ||                // Clip top
+      ((x + w - 1) > _max_x) || // Clip right
+      ((y + h - 1) > _max_y)    // Clip bottom
+  )
+  {
+    Arduino_G::draw16bitRGBBitmapStride(x, y, bitmap, w, h, stride);
+  }
+  else
+  {
+    startWrite();
+    writeAddrWindow(x, y, w, h);
+    while (h--)
+    {
+      _bus->writePixels(bitmap, w);
+      bitmap += stride;
+    }
+    endWrite();
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a RAM-resident 16-bit Big Endian image (RGB 5/6/5) taken
+   out of a wider one, as a single address window.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  first pixel of the image
+    @param    w   Width of image in pixels
+    @param    h   Height of image in pixels
+    @param    stride  Pixels from the start of one row of bitmap to the next
+*/
+/**************************************************************************/
+void Arduino_TFT::draw16bitBeRGBBitmapStride(int16_t x, int16_t y,
+                                             uint16_t *bitmap, int16_t w, int16_t h, int16_t stride)
+{
+  if (
+      (w == stride) ||          // One run
+      (x < 0) ||                // Clip left
+      (y < 0) ||                // Clip top
+      ((x + w - 1) > _max_x) || // Clip right
+      ((y + h - 1) > _max_y)    // Clip bottom
+  )
+  {
+    Arduino_G::draw16bitBeRGBBitmapStride(x, y, bitmap, w, h, stride);
+  }
+  else
+  {
+    startWrite();
+    writeAddrWindow(x, y, w, h);
+    while (h--)
+    {
+      _bus->writeBytes((uint8_t *)bitmap, (uint32_t)w * 2);
+      bitmap += stride;
+    }
+    endWrite();
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief   Draw a PROGMEM-resident 24-bit image (RGB 5/6/5) at the specified (x,y) position.
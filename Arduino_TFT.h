@@ -8,6 +8,10 @@
 #include "Arduino_DataBus.h"
 #include "Arduino_GFX.h"
 
+#if !defined(LITTLE_FOOT_PRINT)
+#define AA_SPAN_PIXELS 32 // pixels buffered per anti-aliased line span
+#endif
+
 class Arduino_TFT : public Arduino_GFX
 {
 public:
@@ -21,6 +25,10 @@ public:
   virtual void writeAddrWindow(int16_t x, int16_t y, uint16_t w, uint16_t h) = 0;
 
   void begin(int32_t speed = GFX_NOT_DEFINED);
+#if !defined(LITTLE_FOOT_PRINT)
+  void beginAsync(int32_t speed = GFX_NOT_DEFINED) override;
+  bool beginPoll() override;
+#endif // !defined(LITTLE_FOOT_PRINT)
   void startWrite(void) override;
   void endWrite(void) override;
   void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
@@ -43,6 +51,7 @@ public:
   void pushColor(uint16_t color);
 
   void writeSlashLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
+  void writeAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint16_t bg) override;
   void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg) override;
   void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg) override;
   void drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h) override;
@@ -51,7 +60,14 @@ public:
   void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask, int16_t w, int16_t h) override;
   void draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) override;
   void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void draw16bitRGBBitmapAsync(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, gfx_async_done_cb_t done = NULL, void *arg = NULL) override;
+  bool supportsAsync() override { return _bus->supportsAsync(); }
+  bool isAsyncBusy() override { return _bus->isBusy(); }
+  void waitAsync() override { _bus->waitAsync(); }
+  bool supportsZeroCopy(const void *data, bool big_endian) override { return _bus->supportsZeroCopy(data, big_endian); }
   void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void draw16bitRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t stride) override;
+  void draw16bitBeRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t stride) override;
   void draw24bitRGBBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h) override;
   void draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) override;
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg) override;
@@ -59,6 +75,18 @@ public:
 
 protected:
   virtual void tftInit() = 0;
+#if !defined(LITTLE_FOOT_PRINT)
+  // Displays with a non-blocking init override both, the default runs tftInit() in one go
+  virtual void tftInitStart() { tftInit(); }
+  virtual bool tftInitPoll() { return true; }
+  void initWait(uint16_t ms);
+  bool initWaiting();
+
+  bool _init_pending = false;
+  uint8_t _init_step = 0;
+  uint16_t _init_wait_ms = 0;
+  uint32_t _init_wait_start = 0;
+#endif // !defined(LITTLE_FOOT_PRINT)
 
   Arduino_DataBus *_bus;
   int8_t _rst;
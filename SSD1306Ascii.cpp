@@ -58,6 +58,7 @@ void SSD1306Ascii::clear(uint8_t c0, uint8_t c1, uint8_t r0, uint8_t r1) {
       ssd1306WriteRamBuf(m_invertMask);
     }
   }
+  endDisplayRun();
   setCursor(c0, r0);
 }
 //------------------------------------------------------------------------------
@@ -379,6 +380,27 @@ size_t SSD1306Ascii::write(uint8_t ch) {
       }
     }
   }
+  endDisplayRun();
   setRow(srow);
   return 1;
 }
+//------------------------------------------------------------------------------
+void SSD1306Ascii::writePages(const uint8_t* buf, uint8_t col, uint8_t row,
+                              uint8_t width, uint8_t rows) {
+  // Cancel skip character pixels.
+  m_skip = 0;
+
+  // Insure only rows on display will be written.
+  if (row >= displayRows()) return;
+  if (rows > displayRows() - row) rows = displayRows() - row;
+
+  for (uint8_t r = 0; r < rows; r++) {
+    setCursor(col, row + r);
+    for (uint8_t c = 0; c < width; c++) {
+      ssd1306WriteRamBuf(buf[c]);
+    }
+    buf += width;
+  }
+  endDisplayRun();
+  setCursor(col, row);
+}
@@ -453,10 +453,25 @@ class SSD1306Ascii : public Print {
    * @return one for success else zero.
    */
   size_t write(uint8_t c);
+  /**
+   * @brief Copy a page format image to display RAM.
+   *
+   * @param[in] buf Image with one byte per column, LSB on top, and
+   *            width bytes per eight pixel row.
+   * @param[in] col Starting column.
+   * @param[in] row Starting row in eight pixel rows.
+   * @param[in] width Image width in pixels.
+   * @param[in] rows Image height in eight pixel rows.
+   * @note The final cursor position will be (col, row).
+   */
+  void writePages(const uint8_t* buf, uint8_t col, uint8_t row,
+                  uint8_t width, uint8_t rows);
 
  protected:
   uint16_t fontSize() const;
   virtual void writeDisplay(uint8_t b, uint8_t mode) = 0;
+  // Called after the last SSD1306_MODE_RAM_BUF byte of a run.
+  virtual void endDisplayRun() {}
   uint8_t m_col;            // Cursor column.
   uint8_t m_row;            // Cursor RAM row.
   uint8_t m_displayWidth;   // Display width.
@@ -25,6 +25,7 @@
 #define SSD1306AsciiSpi_h
 #include <SPI.h>
 #include "SSD1306Ascii.h"
+#include "databus/Arduino_SPIBusManager.h"
 //------------------------------------------------------------------------------
 /**
  * @class SSD1306AsciiSpi
@@ -42,9 +43,19 @@ class SSD1306AsciiSpi : public SSD1306Ascii {
   void begin(const DevType* dev, uint8_t cs, uint8_t dc) {
     m_cs = cs;
     m_dc = dc;
+    m_inTransaction = false;
     pinMode(m_cs, OUTPUT);
+    digitalWrite(m_cs, HIGH);
     pinMode(m_dc, OUTPUT);
     SPI.begin();
+#if defined(SPI_BUS_MANAGER)
+    if (m_manager) {
+      m_device = m_manager->addDevice(8000000, SPI_MODE0);
+      if (m_device == GFX_NOT_DEFINED) {
+        m_manager = nullptr;
+      }
+    }
+#endif  // defined(SPI_BUS_MANAGER)
     init(dev);
   }
   /**
@@ -59,18 +70,64 @@ class SSD1306AsciiSpi : public SSD1306Ascii {
     oledReset(rst);
     begin(dev, cs, dc);
   }
+#if defined(SPI_BUS_MANAGER)
+  /**
+   * @brief Share the bus with other devices, call before begin().
+   *
+   * @param[in] manager The manager of the hardware SPI bus.
+   */
+  void setBusManager(Arduino_SPIBusManager* manager) {
+    m_manager = manager;
+  }
+#endif  // defined(SPI_BUS_MANAGER)
 
  protected:
+  // Buffered RAM bytes share one transaction, like OPTIMIZE_I2C in
+  // SSD1306AsciiWire, until endDisplayRun() closes it.
   void writeDisplay(uint8_t b, uint8_t mode) {
+    if (!m_inTransaction) {
+#if defined(SPI_BUS_MANAGER)
+      if (m_manager) {
+        m_manager->acquireWait(m_device);
+      } else {
+        SPI.beginTransaction(m_settings);
+      }
+#else  // defined(SPI_BUS_MANAGER)
+      SPI.beginTransaction(m_settings);
+#endif  // defined(SPI_BUS_MANAGER)
+      digitalWrite(m_cs, LOW);
+      m_inTransaction = true;
+    }
     digitalWrite(m_dc, mode != SSD1306_MODE_CMD);
-    SPI.beginTransaction(SPISettings(8000000, MSBFIRST, SPI_MODE0));
-    digitalWrite(m_cs, LOW);
     SPI.transfer(b);
+    if (mode != SSD1306_MODE_RAM_BUF) {
+      endDisplayRun();
+    }
+  }
+  void endDisplayRun() {
+    if (!m_inTransaction) {
+      return;
+    }
     digitalWrite(m_cs, HIGH);
+#if defined(SPI_BUS_MANAGER)
+    if (m_manager) {
+      m_manager->release(m_device);
+    } else {
+      SPI.endTransaction();
+    }
+#else  // defined(SPI_BUS_MANAGER)
     SPI.endTransaction();
+#endif  // defined(SPI_BUS_MANAGER)
+    m_inTransaction = false;
   }
 
+  SPISettings m_settings = SPISettings(8000000, MSBFIRST, SPI_MODE0);
   int8_t m_cs;
   int8_t m_dc;
+  bool m_inTransaction = false;
+#if defined(SPI_BUS_MANAGER)
+  Arduino_SPIBusManager* m_manager = nullptr;
+  int8_t m_device = GFX_NOT_DEFINED;
+#endif  // defined(SPI_BUS_MANAGER)
 };
 #endif  // SSD1306AsciiSpi_h
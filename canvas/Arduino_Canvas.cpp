@@ -2,11 +2,49 @@
 #if !defined(LITTLE_FOOT_PRINT)
 
 #include "../Arduino_GFX.h"
+#include "../Arduino_GFX_Alloc.h"
 #include "Arduino_Canvas.h"
 
+// RGB565 spread as 0b00000GGGGGG00000RRRRR000000BBBBB, each channel has room
+// above it for a multiply by a 0..32 alpha
+#define RGB565_SPREAD_MASK 0x07E0F81F
+
+static INLINE uint32_t rgb565_spread(uint16_t c)
+{
+    return ((uint32_t)c | ((uint32_t)c << 16)) & RGB565_SPREAD_MASK;
+}
+
+// fg over bg at alpha 0..32, all three channels in one multiply
+static INLINE uint16_t rgb565_blend(uint32_t fg, uint16_t bg, uint32_t alpha)
+{
+    uint32_t b = rgb565_spread(bg);
+    b = (b + (((fg - b) * alpha) >> 5)) & RGB565_SPREAD_MASK;
+    return (uint16_t)(b | (b >> 16));
+}
+
+// two framebuffer pixels in one word under the same alpha, the spread
+// layout holds one pixel's red and blue and the other's green, so rotating
+// the word by 16 gives the second half
+static INLINE uint32_t rgb565_blend2(uint32_t fg, uint32_t bg, uint32_t alpha)
+{
+    uint32_t lo = bg & RGB565_SPREAD_MASK;
+    uint32_t hi = ((bg >> 16) | (bg << 16)) & RGB565_SPREAD_MASK;
+    lo = (lo + (((fg - lo) * alpha) >> 5)) & RGB565_SPREAD_MASK;
+    hi = (hi + (((fg - hi) * alpha) >> 5)) & RGB565_SPREAD_MASK;
+    return lo | (hi >> 16) | (hi << 16);
+}
+
+static INLINE uint32_t alpha_word(const uint8_t *alpha)
+{
+    uint32_t v;
+    memcpy(&v, alpha, 4);
+    return v;
+}
+
 Arduino_Canvas::Arduino_Canvas(
-    int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y)
-    : Arduino_GFX(w, h), _output(output), _output_x(output_x), _output_y(output_y)
+    int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y, bool big_endian)
+    : Arduino_GFX(w, h), _origin(0), _step_x(1), _step_y(w), _output(output), _output_x(output_x), _output_y(output_y), _big_endian(big_endian), _flush_time(0), _flush_pixels(0),
+      _dirty_count(0), _max_dirty(CANVAS_DIRTY_RECTS)
 {
 }
 
@@ -14,37 +52,182 @@ void Arduino_Canvas::begin(int32_t speed)
 {
     _output->begin(speed);
 
-    size_t s = _width * _height * 2;
-#if defined(ESP32)
-    if (psramFound())
+    _framebuffer = (uint16_t *)gfx_alloc(WIDTH * HEIGHT * 2);
+    if (!_framebuffer)
     {
-        _framebuffer = (uint16_t *)ps_malloc(s);
+        Serial.println(F("_framebuffer allocation failed."));
     }
-    else
+    markAllDirty();
+}
+
+void Arduino_Canvas::setRotation(uint8_t r)
+{
+    Arduino_GFX::setRotation(r);
+    switch (_rotation)
+    {
+    case 1:
+        _origin = WIDTH - 1;
+        _step_x = WIDTH;
+        _step_y = -1;
+        break;
+    case 2:
+        _origin = ((int32_t)HEIGHT * WIDTH) - 1;
+        _step_x = -1;
+        _step_y = -WIDTH;
+        break;
+    case 3:
+        _origin = (int32_t)(HEIGHT - 1) * WIDTH;
+        _step_x = -WIDTH;
+        _step_y = 1;
+        break;
+    default: // case 0:
+        _origin = 0;
+        _step_x = 1;
+        _step_y = WIDTH;
+        break;
+    }
+}
+
+// canvas rectangle to the framebuffer rectangle it covers, rotations turn
+// clockwise as they do on the panels
+void Arduino_Canvas::toFramebuffer(int16_t *x, int16_t *y, int16_t *w, int16_t *h)
+{
+    int16_t t;
+    switch (_rotation)
     {
-        _framebuffer = (uint16_t *)malloc(s);
-        if (!_framebuffer)
+    case 1:
+        t = *x;
+        *x = WIDTH - *y - *h;
+        *y = t;
+        t = *w;
+        *w = *h;
+        *h = t;
+        break;
+    case 2:
+        *x = WIDTH - *x - *w;
+        *y = HEIGHT - *y - *h;
+        break;
+    case 3:
+        t = *x;
+        *x = *y;
+        *y = HEIGHT - t - *w;
+        t = *w;
+        *w = *h;
+        *h = t;
+        break;
+    }
+}
+
+// framebuffer coordinates. Drawing a pixel or a span at a time mostly lands
+// in or next to a region already listed: covered costs four compares, and a
+// region that grows by no more than GFX_RECT_MERGE_SLACK wasted pixels, the
+// merge gfx_add_rect() would make anyway, takes it in place. The latest
+// region is tried first, gfx_add_rect() leaves the one it added or grew at
+// the end. Anything else goes through the list.
+void Arduino_Canvas::addDirty(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    int16_t x2 = x + w, y2 = y + h;
+    for (uint8_t n = _dirty_count; n > 0; n--)
+    {
+        gfx_rect_t *r = &_dirty[n - 1];
+        int16_t r_x2 = r->x + r->w, r_y2 = r->y + r->h;
+        if ((x >= r->x) && (y >= r->y) && (x2 <= r_x2) && (y2 <= r_y2))
+        {
+            return;
+        }
+        int16_t ux = (x < r->x) ? x : r->x;
+        int16_t uy = (y < r->y) ? y : r->y;
+        int16_t ux2 = (x2 > r_x2) ? x2 : r_x2;
+        int16_t uy2 = (y2 > r_y2) ? y2 : r_y2;
+        int16_t ix = ((x2 < r_x2) ? x2 : r_x2) - ((x > r->x) ? x : r->x);
+        int16_t iy = ((y2 < r_y2) ? y2 : r_y2) - ((y > r->y) ? y : r->y);
+        int32_t waste = (int32_t)(ux2 - ux) * (uy2 - uy) - (int32_t)r->w * r->h - (int32_t)w * h;
+        if ((ix > 0) && (iy > 0))
         {
-            // hack for allocate memory over 63,360 pixels
-            s /= 2;
-            _framebuffer = (uint16_t *)malloc(s);
-            uint16_t *tmp = (uint16_t *)malloc(s);
-            UNUSED(tmp);
-            log_v("_framebuffer delta: %d", tmp - _framebuffer);
+            waste += (int32_t)ix * iy;
+        }
+        if (waste <= GFX_RECT_MERGE_SLACK)
+        {
+            r->x = ux;
+            r->y = uy;
+            r->w = ux2 - ux;
+            r->h = uy2 - uy;
+            return;
         }
     }
-#else
-    _framebuffer = (uint16_t *)malloc(s);
-#endif
-    if (!_framebuffer)
+    gfx_rect_t r = {x, y, w, h};
+    gfx_add_rect(_dirty, &_dirty_count, _max_dirty, &r);
+}
+
+void Arduino_Canvas::markDirty(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    if (x < 0)
     {
-        Serial.println(F("_framebuffer allocation failed."));
+        w += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+    if ((x + w) > _width)
+    {
+        w = _width - x;
+    }
+    if ((y + h) > _height)
+    {
+        h = _height - y;
+    }
+    if ((w > 0) && (h > 0))
+    {
+        toFramebuffer(&x, &y, &w, &h);
+        addDirty(x, y, w, h);
     }
 }
 
+void Arduino_Canvas::markAllDirty()
+{
+    _dirty[0].x = 0;
+    _dirty[0].y = 0;
+    _dirty[0].w = WIDTH;
+    _dirty[0].h = HEIGHT;
+    _dirty_count = 1;
+}
+
+void Arduino_Canvas::setMaxDirtyRects(uint8_t max_rects)
+{
+    if (max_rects < 1)
+    {
+        max_rects = 1;
+    }
+    else if (max_rects > CANVAS_DIRTY_RECTS)
+    {
+        max_rects = CANVAS_DIRTY_RECTS;
+    }
+    if (_dirty_count > max_rects)
+    {
+        // merge the surplus into what stays
+        uint8_t count = max_rects;
+        for (uint8_t i = max_rects; i < _dirty_count; i++)
+        {
+            gfx_add_rect(_dirty, &count, max_rects, &_dirty[i]);
+        }
+        _dirty_count = count;
+    }
+    _max_dirty = max_rects;
+}
+
 void Arduino_Canvas::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
 {
-    _framebuffer[((int32_t)y * _width) + x] = color;
+    if (_big_endian)
+    {
+        MSB_16_SET(color, color);
+    }
+    int16_t w = 1, h = 1;
+    toFramebuffer(&x, &y, &w, &h);
+    _framebuffer[((int32_t)y * WIDTH) + x] = color;
+    addDirty(x, y, 1, 1);
 }
 
 void Arduino_Canvas::writeFastVLine(int16_t x, int16_t y,
@@ -72,13 +255,7 @@ void Arduino_Canvas::writeFastVLine(int16_t x, int16_t y,
                 {
                     h = _max_y - y + 1;
                 } // Clip bottom
-
-                uint16_t *fb = _framebuffer + ((int32_t)y * _width) + x;
-                while (h--)
-                {
-                    *fb = color;
-                    fb += _width;
-                }
+                writeFillRectPreclipped(x, y, 1, h, color);
             }
         }
     }
@@ -109,12 +286,7 @@ void Arduino_Canvas::writeFastHLine(int16_t x, int16_t y,
                 {
                     w = _max_x - x + 1;
                 } // Clip right
-
-                uint16_t *fb = _framebuffer + ((int32_t)y * _width) + x;
-                while (w--)
-                {
-                    *(fb++) = color;
-                }
+                writeFillRectPreclipped(x, y, w, 1, color);
             }
         }
     }
@@ -123,16 +295,110 @@ void Arduino_Canvas::writeFastHLine(int16_t x, int16_t y,
 void Arduino_Canvas::writeFillRectPreclipped(int16_t x, int16_t y,
                                              int16_t w, int16_t h, uint16_t color)
 {
+    if (_big_endian)
+    {
+        MSB_16_SET(color, color);
+    }
+    // a rectangle stays one whatever the rotation, fill it in framebuffer order
+    toFramebuffer(&x, &y, &w, &h);
+    addDirty(x, y, w, h);
     uint16_t *row = _framebuffer;
-    row += y * _width;
+    row += (int32_t)y * WIDTH;
     row += x;
+    if (w == 1)
+    {
+        while (h--)
+        {
+            *row = color;
+            row += WIDTH;
+        }
+        return;
+    }
     for (int j = 0; j < h; j++)
     {
         for (int i = 0; i < w; i++)
         {
             row[i] = color;
         }
-        row += _width;
+        row += WIDTH;
+    }
+}
+
+// copies a clipped bitmap into the framebuffer with the offsets setRotation()
+// worked out, no coordinate is transformed per pixel
+void Arduino_Canvas::blit(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h, int16_t stride, bool swap)
+{
+    int16_t fx = x, fy = y, fw = w, fh = h;
+    toFramebuffer(&fx, &fy, &fw, &fh);
+    addDirty(fx, fy, fw, fh);
+    uint16_t *dst = _framebuffer + _origin + (x * _step_x) + (y * _step_y);
+    uint16_t c;
+    if (_step_x == 1)
+    {
+        for (int16_t j = 0; j < h; j++)
+        {
+            if (swap)
+            {
+                Arduino_DataBus::swapPixels(dst, bitmap, w);
+            }
+            else
+            {
+                memcpy(dst, bitmap, w * 2);
+            }
+            bitmap += stride;
+            dst += _step_y;
+        }
+    }
+    else if (_step_x == -1)
+    {
+        // upside down, every bitmap row lands reversed on one framebuffer row
+        for (int16_t j = 0; j < h; j++)
+        {
+            uint16_t *d = dst;
+            for (int16_t i = 0; i < w; i++)
+            {
+                c = bitmap[i];
+                if (swap)
+                {
+                    MSB_16_SET(c, c);
+                }
+                *(d--) = c;
+            }
+            bitmap += stride;
+            dst += _step_y;
+        }
+    }
+    else
+    {
+        // a quarter turn makes bitmap columns framebuffer rows, transpose a
+        // tile at a time so the rows read and the rows written stay cached
+        for (int16_t ty = 0; ty < h; ty += CANVAS_BLIT_TILE)
+        {
+            int16_t th = ((h - ty) < CANVAS_BLIT_TILE) ? (h - ty) : CANVAS_BLIT_TILE;
+            for (int16_t tx = 0; tx < w; tx += CANVAS_BLIT_TILE)
+            {
+                int16_t tw = ((w - tx) < CANVAS_BLIT_TILE) ? (w - tx) : CANVAS_BLIT_TILE;
+                const uint16_t *src = bitmap + ((int32_t)ty * stride) + tx;
+                uint16_t *out = dst + (tx * _step_x) + (ty * _step_y);
+                for (int16_t i = 0; i < tw; i++)
+                {
+                    const uint16_t *s = src + i;
+                    uint16_t *d = out;
+                    for (int16_t j = 0; j < th; j++)
+                    {
+                        c = *s;
+                        if (swap)
+                        {
+                            MSB_16_SET(c, c);
+                        }
+                        *d = c;
+                        s += stride;
+                        d += _step_y;
+                    }
+                    out += _step_x;
+                }
+            }
+        }
     }
 }
 
@@ -173,18 +439,7 @@ void Arduino_Canvas::draw16bitRGBBitmap(int16_t x, int16_t y,
             w += x;
             x = 0;
         }
-        uint16_t *row = _framebuffer;
-        row += y * _width;
-        row += x;
-        for (int j = 0; j < h; j++)
-        {
-            for (int i = 0; i < w; i++)
-            {
-                row[i] = *bitmap++;
-            }
-            bitmap += xskip;
-            row += _width;
-        }
+        blit(x, y, bitmap, w, h, w + xskip, _big_endian);
     }
 }
 
@@ -225,26 +480,335 @@ void Arduino_Canvas::draw16bitBeRGBBitmap(int16_t x, int16_t y,
             w += x;
             x = 0;
         }
-        uint16_t *row = _framebuffer;
-        row += y * _width;
-        row += x;
-        uint16_t color;
-        for (int j = 0; j < h; j++)
+        blit(x, y, bitmap, w, h, w + xskip, !_big_endian);
+    }
+}
+
+void Arduino_Canvas::readRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *dst)
+{
+    uint16_t *row = _framebuffer + _origin + (x * _step_x) + (y * _step_y);
+    for (int16_t j = 0; j < h; j++)
+    {
+        if (_step_x == 1)
+        {
+            if (_big_endian)
+            {
+                Arduino_DataBus::swapPixels(dst, row, w);
+            }
+            else
+            {
+                memcpy(dst, row, w * 2);
+            }
+        }
+        else
+        {
+            uint16_t *s = row;
+            for (int16_t i = 0; i < w; i++)
+            {
+                uint16_t c = *s;
+                if (_big_endian)
+                {
+                    MSB_16_SET(c, c);
+                }
+                dst[i] = c;
+                s += _step_x;
+            }
+        }
+        dst += w;
+        row += _step_y;
+    }
+}
+
+void Arduino_Canvas::drawAlphaBitmap(int16_t x, int16_t y,
+                                     uint16_t *bitmap, uint8_t *alpha, int16_t w, int16_t h)
+{
+    drawAlpha(x, y, bitmap, 0, alpha, w, h);
+}
+
+void Arduino_Canvas::fillAlphaMask(int16_t x, int16_t y,
+                                   uint8_t *coverage, int16_t w, int16_t h, uint16_t color)
+{
+    drawAlpha(x, y, NULL, color, coverage, w, h);
+}
+
+// bitmap NULL blends the one color through the mask
+void Arduino_Canvas::drawAlpha(int16_t x, int16_t y, const uint16_t *bitmap, uint16_t color,
+                               const uint8_t *alpha, int16_t w, int16_t h)
+{
+    if (
+        ((x + w - 1) < 0) || // Outside left
+        ((y + h - 1) < 0) || // Outside top
+        (x > _max_x) ||      // Outside right
+        (y > _max_y)         // Outside bottom
+    )
+    {
+        return;
+    }
+    int16_t stride = w;
+    if ((y + h - 1) > _max_y)
+    {
+        h -= (y + h - 1) - _max_y;
+    }
+    if (y < 0)
+    {
+        alpha -= y * stride;
+        if (bitmap)
+        {
+            bitmap -= y * stride;
+        }
+        h += y;
+        y = 0;
+    }
+    if ((x + w - 1) > _max_x)
+    {
+        w -= (x + w - 1) - _max_x;
+    }
+    if (x < 0)
+    {
+        alpha -= x;
+        if (bitmap)
+        {
+            bitmap -= x;
+        }
+        w += x;
+        x = 0;
+    }
+
+    int16_t fx = x, fy = y, fw = w, fh = h;
+    toFramebuffer(&fx, &fy, &fw, &fh);
+    addDirty(fx, fy, fw, fh);
+    uint16_t *row = _framebuffer + _origin + (x * _step_x) + (y * _step_y);
+    for (int16_t j = 0; j < h; j++)
+    {
+        blendSpan(row, _step_x, bitmap, color, alpha, w);
+        if (bitmap)
+        {
+            bitmap += stride;
+        }
+        alpha += stride;
+        row += _step_y;
+    }
+}
+
+// transparent runs are skipped and opaque ones copied a word of alpha at a
+// time, only the pixels in between are blended
+void Arduino_Canvas::blendSpan(uint16_t *dst, int32_t step, const uint16_t *src, uint16_t color,
+                               const uint8_t *alpha, int16_t w)
+{
+    uint32_t fg = rgb565_spread(color);
+    uint16_t c;
+    int16_t i = 0;
+    while (i < w)
+    {
+        uint8_t a = alpha[i];
+        if (a == 0)
         {
-            for (int i = 0; i < w; i++)
+            i++;
+            while (((i + 4) <= w) && (alpha_word(alpha + i) == 0))
+            {
+                i += 4;
+            }
+            while ((i < w) && (alpha[i] == 0))
             {
-                color = *bitmap++;
-                MSB_16_SET(row[i], color);
+                i++;
             }
-            bitmap += xskip;
-            row += _width;
+        }
+        else if (a == 0xFF)
+        {
+            int16_t start = i++;
+            while (((i + 4) <= w) && (alpha_word(alpha + i) == 0xFFFFFFFF))
+            {
+                i += 4;
+            }
+            while ((i < w) && (alpha[i] == 0xFF))
+            {
+                i++;
+            }
+            int16_t len = i - start;
+            uint16_t *d = dst + (start * step);
+            if (src && (step == 1))
+            {
+                if (_big_endian)
+                {
+                    Arduino_DataBus::swapPixels(d, src + start, len);
+                }
+                else
+                {
+                    memcpy(d, src + start, len * 2);
+                }
+            }
+            else
+            {
+                for (int16_t k = start; k < i; k++)
+                {
+                    c = src ? src[k] : color;
+                    if (_big_endian)
+                    {
+                        MSB_16_SET(c, c);
+                    }
+                    *d = c;
+                    d += step;
+                }
+            }
+        }
+        else
+        {
+            uint16_t *d = dst + (i * step);
+            c = *d;
+            if (_big_endian)
+            {
+                MSB_16_SET(c, c);
+            }
+            c = rgb565_blend(src ? rgb565_spread(src[i]) : fg, c, (a + 4) >> 3);
+            if (_big_endian)
+            {
+                MSB_16_SET(c, c);
+            }
+            *d = c;
+            i++;
         }
     }
 }
 
+// one alpha for the whole rectangle, framebuffer rows are blended two
+// pixels to a word
+void Arduino_Canvas::fillRectAlpha(int16_t x, int16_t y,
+                                   int16_t w, int16_t h, uint16_t color, uint8_t alpha)
+{
+    if (alpha == 0)
+    {
+        return;
+    }
+    if (alpha == 0xFF)
+    {
+        fillRect(x, y, w, h, color);
+        return;
+    }
+    if (w < 0)
+    {
+        x += w + 1;
+        w = -w;
+    }
+    if (h < 0)
+    {
+        y += h + 1;
+        h = -h;
+    }
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+    if ((x + w - 1) > _max_x)
+    {
+        w = _max_x - x + 1;
+    }
+    if ((y + h - 1) > _max_y)
+    {
+        h = _max_y - y + 1;
+    }
+    if ((w <= 0) || (h <= 0))
+    {
+        return;
+    }
+
+    toFramebuffer(&x, &y, &w, &h);
+    addDirty(x, y, w, h);
+    uint32_t a = (alpha + 4) >> 3;
+    uint32_t fg = rgb565_spread(color);
+    uint16_t c;
+    uint16_t *row = _framebuffer + ((int32_t)y * WIDTH) + x;
+    for (int16_t j = 0; j < h; j++)
+    {
+        uint16_t *d = row;
+        int16_t n = w;
+        if ((uintptr_t)d & 2)
+        {
+            c = *d;
+            if (_big_endian)
+            {
+                MSB_16_SET(c, c);
+            }
+            c = rgb565_blend(fg, c, a);
+            if (_big_endian)
+            {
+                MSB_16_SET(c, c);
+            }
+            *(d++) = c;
+            n--;
+        }
+        uint32_t *d32 = (uint32_t *)d;
+        for (int16_t k = n >> 1; k > 0; k--)
+        {
+            uint32_t v = *d32;
+            if (_big_endian)
+            {
+                v = ((v & 0xFF00FF00) >> 8) | ((v & 0x00FF00FF) << 8);
+                v = rgb565_blend2(fg, v, a);
+                v = ((v & 0xFF00FF00) >> 8) | ((v & 0x00FF00FF) << 8);
+            }
+            else
+            {
+                v = rgb565_blend2(fg, v, a);
+            }
+            *(d32++) = v;
+        }
+        if (n & 1)
+        {
+            d = (uint16_t *)d32;
+            c = *d;
+            if (_big_endian)
+            {
+                MSB_16_SET(c, c);
+            }
+            c = rgb565_blend(fg, c, a);
+            if (_big_endian)
+            {
+                MSB_16_SET(c, c);
+            }
+            *d = c;
+        }
+        row += WIDTH;
+    }
+}
+
 void Arduino_Canvas::flush()
 {
-    _output->draw16bitRGBBitmap(_output_x, _output_y, _framebuffer, _width, _height);
+    uint32_t start = micros();
+    bool zero_copy = _output->supportsZeroCopy(_framebuffer, _big_endian);
+    _flush_pixels = 0;
+    for (uint8_t i = 0; i < _dirty_count; i++)
+    {
+        _flush_pixels += sendRect(_framebuffer, _dirty[i], zero_copy);
+    }
+    _dirty_count = 0;
+    _flush_time = micros() - start;
+}
+
+// A bus that sends straight from memory does best with one contiguous run,
+// so a nearly full-width rect goes out as whole rows. Returns pixels sent.
+uint32_t Arduino_Canvas::sendRect(uint16_t *buffer, gfx_rect_t r, bool zero_copy)
+{
+    if (zero_copy && (((int32_t)r.w * 4) >= ((int32_t)WIDTH * 3)))
+    {
+        r.x = 0;
+        r.w = WIDTH;
+    }
+    uint16_t *fb = buffer + ((int32_t)r.y * WIDTH) + r.x;
+    if (_big_endian)
+    {
+        _output->draw16bitBeRGBBitmapStride(_output_x + r.x, _output_y + r.y, fb, r.w, r.h, WIDTH);
+    }
+    else
+    {
+        _output->draw16bitRGBBitmapStride(_output_x + r.x, _output_y + r.y, fb, r.w, r.h, WIDTH);
+    }
+    return (uint32_t)r.w * r.h;
 }
 
 #endif // !defined(LITTLE_FOOT_PRINT)
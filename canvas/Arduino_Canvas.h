@@ -6,12 +6,21 @@
 
 #include "../Arduino_GFX.h"
 
+#ifndef CANVAS_DIRTY_RECTS
+#define CANVAS_DIRTY_RECTS 8 // most regions flush() sends separately
+#endif
+#ifndef CANVAS_BLIT_TILE
+#define CANVAS_BLIT_TILE 16 // side of the square a rotated bitmap blit transposes at a time
+#endif
+
 class Arduino_Canvas : public Arduino_GFX
 {
 public:
-  Arduino_Canvas(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0);
+  // big_endian keeps the framebuffer in wire byte order so flush() sends it without a swap
+  Arduino_Canvas(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0, bool big_endian = false);
 
   void begin(int32_t speed = GFX_NOT_DEFINED) override;
+  void setRotation(uint8_t r) override;
   void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
   void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
   void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
@@ -20,10 +29,47 @@ public:
   void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
   void flush(void) override;
 
+  // alpha and coverage run 0 (canvas untouched) to 255 (fully covered)
+  void drawAlphaBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *alpha, int16_t w, int16_t h);
+  void fillAlphaMask(int16_t x, int16_t y, uint8_t *coverage, int16_t w, int16_t h, uint16_t color);
+  void fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha);
+  // copies out a rectangle inside the canvas, in canvas orientation and native byte order
+  void readRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t *dst);
+
+  // WIDTH x HEIGHT in the output's orientation whatever the canvas rotation,
+  // setRotation() only changes how drawing maps onto it
+  uint16_t *getFramebuffer() { return _framebuffer; }
+  bool isBigEndian() { return _big_endian; }
+  uint32_t getFlushTime() { return _flush_time; }     // microseconds taken by the last flush()
+  uint32_t getFlushPixels() { return _flush_pixels; } // pixels sent by the last flush()
+
+  // flush() sends only what was drawn since the last one, drawing straight
+  // into getFramebuffer() has to be marked here, in canvas coordinates
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  void markAllDirty();
+  // fewer regions merge sooner into larger ones, 1 sends a single bounding box
+  void setMaxDirtyRects(uint8_t max_rects);
+
 protected:
+  void addDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  void toFramebuffer(int16_t *x, int16_t *y, int16_t *w, int16_t *h);
+  void blit(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h, int16_t stride, bool swap);
+  void drawAlpha(int16_t x, int16_t y, const uint16_t *bitmap, uint16_t color, const uint8_t *alpha, int16_t w, int16_t h);
+  void blendSpan(uint16_t *dst, int32_t step, const uint16_t *src, uint16_t color, const uint8_t *alpha, int16_t w);
+  uint32_t sendRect(uint16_t *buffer, gfx_rect_t r, bool zero_copy);
+
   uint16_t *_framebuffer;
+  // framebuffer offset of canvas pixel (0, 0) and the offset change for a
+  // step along canvas x and y, set by setRotation()
+  int32_t _origin, _step_x, _step_y;
   Arduino_G *_output;
   int16_t _output_x, _output_y;
+  bool _big_endian;
+  uint32_t _flush_time;
+  uint32_t _flush_pixels;
+  gfx_rect_t _dirty[CANVAS_DIRTY_RECTS];
+  uint8_t _dirty_count;
+  uint8_t _max_dirty;
 
 private:
 };
@@ -2,10 +2,18 @@
 #if !defined(LITTLE_FOOT_PRINT)
 
 #include "../Arduino_GFX.h"
+#include "../Arduino_GFX_Alloc.h"
 #include "Arduino_Canvas_3bit.h"
 
+static inline uint8_t color_3bit(uint16_t color)
+{
+    return (((color & 0b1000000000000000) ? 0b100 : 0) |
+            ((color & 0b0000010000000000) ? 0b010 : 0) |
+            ((color & 0b0000000000010000) ? 0b001 : 0));
+}
+
 Arduino_Canvas_3bit::Arduino_Canvas_3bit(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y)
-    : Arduino_GFX(w, h), _output(output), _output_x(output_x), _output_y(output_y)
+    : Arduino_GFX(w, h), _output(output), _output_x(output_x), _output_y(output_y), _dirty_rows(NULL)
 {
 }
 
@@ -14,21 +22,38 @@ void Arduino_Canvas_3bit::begin(int32_t speed)
     _output->begin(speed);
 
     size_t s = (_width * _height + 1) / 2;
-#if defined(ESP32)
-    if (psramFound())
+    _framebuffer = (uint8_t *)gfx_alloc(s);
+    if (!_framebuffer)
     {
-        _framebuffer = (uint8_t *)ps_malloc(s);
+        Serial.println(F("_framebuffer allocation failed."));
     }
-    else
+    _dirty_rows = (uint8_t *)gfx_alloc((_height + 7) / 8, GFX_MEM_INTERNAL);
+    if (!_dirty_rows)
     {
-        _framebuffer = (uint8_t *)malloc(s);
+        // still works, every flush() sends the whole frame
+        Serial.println(F("_dirty_rows allocation failed, flushing full frames."));
     }
-#else
-    _framebuffer = (uint8_t *)malloc(s);
-#endif
-    if (!_framebuffer)
+    markAllDirty();
+}
+
+void Arduino_Canvas_3bit::markAllDirty()
+{
+    if (_dirty_rows)
     {
-        Serial.println(F("_framebuffer allocation failed."));
+        memset(_dirty_rows, 0xFF, (_height + 7) / 8);
+    }
+}
+
+INLINE void Arduino_Canvas_3bit::markRows(int16_t y, int16_t h)
+{
+    if (!_dirty_rows)
+    {
+        return;
+    }
+    while (h--)
+    {
+        _dirty_rows[y >> 3] |= 1 << (y & 7);
+        y++;
     }
 }
 
@@ -36,9 +61,7 @@ void Arduino_Canvas_3bit::writePixelPreclipped(int16_t x, int16_t y, uint16_t co
 {
     int32_t pos = x + (y * _width);
     int32_t idx = pos >> 1;
-    uint8_t c = (((color & 0b1000000000000000) ? 0b100 : 0) |
-                 ((color & 0b0000010000000000) ? 0b010 : 0) |
-                 ((color & 0b0000000000010000) ? 0b001 : 0));
+    uint8_t c = color_3bit(color);
     if (pos & 1)
     {
         _framebuffer[idx] = (_framebuffer[idx] & 0b00111000) | c;
@@ -47,11 +70,133 @@ void Arduino_Canvas_3bit::writePixelPreclipped(int16_t x, int16_t y, uint16_t co
     {
         _framebuffer[idx] = (_framebuffer[idx] & 0b00000111) | (c << 3);
     }
+    markRows(y, 1);
+}
+
+void Arduino_Canvas_3bit::writeFastVLine(int16_t x, int16_t y,
+                                         int16_t h, uint16_t color)
+{
+    if (_ordered_in_range(x, 0, _max_x) && h)
+    { // X on screen, nonzero height
+        if (h < 0)
+        {               // If negative height...
+            y += h + 1; //   Move Y to top edge
+            h = -h;     //   Use positive height
+        }
+        if (y <= _max_y)
+        { // Not off bottom
+            int16_t y2 = y + h - 1;
+            if (y2 >= 0)
+            { // Not off top
+                // Line partly or fully overlaps screen
+                if (y < 0)
+                {
+                    y = 0;
+                    h = y2 + 1;
+                } // Clip top
+                if (y2 > _max_y)
+                {
+                    h = _max_y - y + 1;
+                } // Clip bottom
+                writeFillRectPreclipped(x, y, 1, h, color);
+            }
+        }
+    }
+}
+
+void Arduino_Canvas_3bit::writeFastHLine(int16_t x, int16_t y,
+                                         int16_t w, uint16_t color)
+{
+    if (_ordered_in_range(y, 0, _max_y) && w)
+    { // Y on screen, nonzero width
+        if (w < 0)
+        {               // If negative width...
+            x += w + 1; //   Move X to left edge
+            w = -w;     //   Use positive width
+        }
+        if (x <= _max_x)
+        { // Not off right
+            int16_t x2 = x + w - 1;
+            if (x2 >= 0)
+            { // Not off left
+                // Line partly or fully overlaps screen
+                if (x < 0)
+                {
+                    x = 0;
+                    w = x2 + 1;
+                } // Clip left
+                if (x2 > _max_x)
+                {
+                    w = _max_x - x + 1;
+                } // Clip right
+                writeFillRectPreclipped(x, y, w, 1, color);
+            }
+        }
+    }
+}
+
+// odd nibbles at either end of a row span, whole bytes in between
+void Arduino_Canvas_3bit::writeFillRectPreclipped(int16_t x, int16_t y,
+                                                  int16_t w, int16_t h, uint16_t color)
+{
+    uint8_t c = color_3bit(color);
+    uint8_t pair = (c << 3) | c;
+    int32_t pos = x + ((int32_t)y * _width);
+    markRows(y, h);
+    for (int16_t j = 0; j < h; j++)
+    {
+        int32_t p = pos;
+        int16_t n = w;
+        if (p & 1)
+        {
+            _framebuffer[p >> 1] = (_framebuffer[p >> 1] & 0b00111000) | c;
+            p++;
+            n--;
+        }
+        if (n >= 2)
+        {
+            memset(_framebuffer + (p >> 1), pair, n >> 1);
+            p += n & ~1;
+        }
+        if (n & 1)
+        {
+            _framebuffer[p >> 1] = (_framebuffer[p >> 1] & 0b00000111) | (c << 3);
+        }
+        pos += _width;
+    }
 }
 
 void Arduino_Canvas_3bit::flush()
 {
-    _output->draw3bitRGBBitmap(_output_x, _output_y, _framebuffer, _width, _height);
+    if ((_width & 1) || (!_dirty_rows))
+    {
+        // rows of an odd width canvas do not start on a byte, and without
+        // the row bits nothing tells which rows changed
+        _output->draw3bitRGBBitmap(_output_x, _output_y, _framebuffer, _width, _height);
+        if (_dirty_rows)
+        {
+            memset(_dirty_rows, 0, (_height + 7) / 8);
+        }
+        return;
+    }
+    int16_t y = 0;
+    while (y < _height)
+    {
+        if (!(_dirty_rows[y >> 3] & (1 << (y & 7))))
+        {
+            y++;
+            continue;
+        }
+        // one bitmap per band of changed rows, already in the panel's packing
+        int16_t y2 = y;
+        while ((y2 < _height) && (_dirty_rows[y2 >> 3] & (1 << (y2 & 7))))
+        {
+            y2++;
+        }
+        _output->draw3bitRGBBitmap(_output_x, _output_y + y, _framebuffer + ((int32_t)y * _width / 2), _width, y2 - y);
+        y = y2;
+    }
+    memset(_dirty_rows, 0, (_height + 7) / 8);
 }
 
 #endif // !defined(LITTLE_FOOT_PRINT)
@@ -13,12 +13,21 @@ public:
 
   void begin(int32_t speed = GFX_NOT_DEFINED) override;
   void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
-  void flush(void) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void flush(void) override; // sends the changed rows only
+
+  uint8_t *getFramebuffer() { return _framebuffer; }
+  void markAllDirty();
 
 protected:
-  uint8_t *_framebuffer;
+  INLINE void markRows(int16_t y, int16_t h);
+
+  uint8_t *_framebuffer; // 2 pixels per byte, 0b00RGBrgb as Arduino_ILI9488_3bit takes them
   Arduino_G *_output;
   int16_t _output_x, _output_y;
+  uint8_t *_dirty_rows; // one bit per row changed since the last flush()
 
 private:
 };
@@ -0,0 +1,188 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "../Arduino_GFX_Alloc.h"
+#include "Arduino_Canvas_DoubleBuffer.h"
+
+Arduino_Canvas_DoubleBuffer::Arduino_Canvas_DoubleBuffer(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y, bool big_endian)
+    : Arduino_Canvas(w, h, output, output_x, output_y, big_endian),
+      _front(NULL), _front_count(0), _flushing(false), _send_start(0), _wait_time(0), _draw_time(0), _flush_end(0)
+{
+}
+
+void Arduino_Canvas_DoubleBuffer::begin(int32_t speed)
+{
+    Arduino_Canvas::begin(speed);
+    if (!_framebuffer)
+    {
+        return;
+    }
+
+    size_t s = WIDTH * HEIGHT * 2;
+    _front = (uint16_t *)gfx_alloc(s);
+    if (!_front)
+    {
+        Serial.println(F("_front allocation failed, flushing from one buffer."));
+        return;
+    }
+
+#if defined(ESP32)
+    if (xTaskCreatePinnedToCore(flushTask, "canvas_flush", CANVAS_FLUSH_TASK_STACK, this, 1, &_task, CANVAS_FLUSH_TASK_CORE) != pdPASS)
+    {
+        Serial.println(F("canvas_flush task creation failed, flushing from one buffer."));
+        gfx_free(_front);
+        _front = NULL;
+    }
+#endif
+}
+
+void Arduino_Canvas_DoubleBuffer::flush()
+{
+    if (!_front)
+    {
+        Arduino_Canvas::flush();
+        return;
+    }
+
+    uint32_t start = micros();
+    _draw_time = start - _flush_end;
+    waitFlush();
+    _wait_time = micros() - start;
+
+    // the frame just drawn becomes the front buffer
+    uint16_t *drawn = _framebuffer;
+    _framebuffer = _front;
+    _front = drawn;
+    memcpy(_front_dirty, _dirty, _dirty_count * sizeof(gfx_rect_t));
+    _front_count = _dirty_count;
+    _dirty_count = 0;
+    sendFront();
+
+    // the new back buffer still holds the frame before, catch it up while
+    // the front one is on its way
+    for (uint8_t i = 0; i < _front_count; i++)
+    {
+        gfx_rect_t *r = &_front_dirty[i];
+        int32_t offset = ((int32_t)r->y * WIDTH) + r->x;
+        uint16_t *src = _front + offset;
+        uint16_t *dst = _framebuffer + offset;
+        for (int16_t j = 0; j < r->h; j++)
+        {
+            memcpy(dst, src, r->w * 2);
+            src += WIDTH;
+            dst += WIDTH;
+        }
+    }
+    _flush_end = micros();
+}
+
+bool Arduino_Canvas_DoubleBuffer::isFlushing()
+{
+#if !defined(ESP32)
+    if (_flushing)
+    {
+        // buses without a completion interrupt finish the transfer when polled
+        _output->isAsyncBusy();
+    }
+#endif
+    return _flushing;
+}
+
+void Arduino_Canvas_DoubleBuffer::waitFlush()
+{
+#if !defined(ESP32)
+    if (_flushing)
+    {
+        _output->waitAsync();
+    }
+#endif
+    while (_flushing)
+    {
+        yield();
+    }
+}
+
+void Arduino_Canvas_DoubleBuffer::sendFront()
+{
+#if !defined(ESP32)
+    uint32_t last_time = _flush_time;
+    uint32_t last_pixels = _flush_pixels;
+#endif
+    _flushing = true;
+    _send_start = micros();
+    _flush_pixels = 0;
+#if defined(ESP32)
+    xTaskNotifyGive(_task);
+#else
+    if (_big_endian || (_front_count == 0) || !_output->supportsAsync())
+    {
+        // no async path for big-endian bitmaps, nor on buses without DMA
+        sendFrontRects();
+        sendDone(this);
+        return;
+    }
+    // whole rows are contiguous in the framebuffer, send the band holding
+    // every dirty rectangle as one async bitmap
+    int16_t y1 = _front_dirty[0].y;
+    int16_t y2 = y1 + _front_dirty[0].h;
+    uint32_t dirty_pixels = 0;
+    for (uint8_t i = 0; i < _front_count; i++)
+    {
+        gfx_rect_t *r = &_front_dirty[i];
+        if (r->y < y1)
+        {
+            y1 = r->y;
+        }
+        if ((r->y + r->h) > y2)
+        {
+            y2 = r->y + r->h;
+        }
+        dirty_pixels += (uint32_t)r->w * r->h;
+    }
+    _flush_pixels = (uint32_t)WIDTH * (y2 - y1);
+    // the band goes out while the next frame is drawn, the rectangles alone
+    // hold up the caller until sent. At the pixel rate of the last transfer,
+    // keep the band unless it takes the bus longer than that drawing and
+    // the rectangles together, e.g. for a tall narrow rectangle.
+    if (last_pixels && (((uint64_t)_flush_pixels * last_time) > (((uint64_t)_draw_time * last_pixels) + ((uint64_t)dirty_pixels * last_time))))
+    {
+        _flush_pixels = 0;
+        sendFrontRects();
+        sendDone(this);
+        return;
+    }
+    _output->draw16bitRGBBitmapAsync(_output_x, _output_y + y1, _front + ((int32_t)y1 * WIDTH), WIDTH, y2 - y1, sendDone, this);
+#endif
+}
+
+void Arduino_Canvas_DoubleBuffer::sendFrontRects()
+{
+    bool zero_copy = _output->supportsZeroCopy(_front, _big_endian);
+    for (uint8_t i = 0; i < _front_count; i++)
+    {
+        _flush_pixels += sendRect(_front, _front_dirty[i], zero_copy);
+    }
+}
+
+void Arduino_Canvas_DoubleBuffer::sendDone(void *arg)
+{
+    Arduino_Canvas_DoubleBuffer *canvas = (Arduino_Canvas_DoubleBuffer *)arg;
+    canvas->_flush_time = micros() - canvas->_send_start;
+    canvas->_flushing = false;
+}
+
+#if defined(ESP32)
+void Arduino_Canvas_DoubleBuffer::flushTask(void *arg)
+{
+    Arduino_Canvas_DoubleBuffer *canvas = (Arduino_Canvas_DoubleBuffer *)arg;
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        canvas->sendFrontRects();
+        sendDone(canvas);
+    }
+}
+#endif
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,63 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_CANVAS_DOUBLEBUFFER_H_
+#define _ARDUINO_CANVAS_DOUBLEBUFFER_H_
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas.h"
+
+#if defined(ESP32)
+#ifndef CANVAS_FLUSH_TASK_CORE
+#define CANVAS_FLUSH_TASK_CORE 0 // loop() runs on core 1 of dual core chips
+#endif
+#ifndef CANVAS_FLUSH_TASK_STACK
+#define CANVAS_FLUSH_TASK_STACK 2048
+#endif
+#endif
+
+// Draws the next frame into one framebuffer while the other is still being
+// sent, flush() swaps them and returns once the transfer has started. On ESP32
+// a task on the other core sends the frame, elsewhere the display's async
+// bitmap path sends the rows holding every change, unless sending only the
+// changed rectangles while the caller waits is quicker. Falls back to
+// Arduino_Canvas if the second buffer cannot be allocated. getFlushTime() and
+// getFlushPixels() describe the last frame whose transfer has finished.
+class Arduino_Canvas_DoubleBuffer : public Arduino_Canvas
+{
+public:
+  Arduino_Canvas_DoubleBuffer(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0, bool big_endian = false);
+
+  void begin(int32_t speed = GFX_NOT_DEFINED) override;
+  void flush(void) override;
+
+  bool isFlushing();
+  void waitFlush();
+  uint32_t getWaitTime() { return _wait_time; } // microseconds the last flush() waited for the frame before
+
+protected:
+  void sendFront();
+  void sendFrontRects();
+  static void sendDone(void *arg);
+#if defined(ESP32)
+  static void flushTask(void *arg);
+#endif
+
+  uint16_t *_front;
+  gfx_rect_t _front_dirty[CANVAS_DIRTY_RECTS];
+  uint8_t _front_count;
+  volatile bool _flushing;
+  uint32_t _send_start;
+  uint32_t _wait_time;
+  uint32_t _draw_time; // from the end of the last flush() to the start of this one
+  uint32_t _flush_end;
+#if defined(ESP32)
+  TaskHandle_t _task;
+#endif
+
+private:
+};
+
+#endif // _ARDUINO_CANVAS_DOUBLEBUFFER_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
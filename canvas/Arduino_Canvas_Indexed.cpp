@@ -2,6 +2,7 @@
 #if !defined(LITTLE_FOOT_PRINT)
 
 #include "../Arduino_GFX.h"
+#include "../Arduino_GFX_Alloc.h"
 #include "Arduino_Canvas_Indexed.h"
 
 Arduino_Canvas_Indexed::Arduino_Canvas_Indexed(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y, uint8_t mask_level)
@@ -13,6 +14,12 @@ Arduino_Canvas_Indexed::Arduino_Canvas_Indexed(int16_t w, int16_t h, Arduino_G *
     }
     _current_mask_level = mask_level;
     _color_mask = mask_level_list[_current_mask_level];
+    memset(_color_hash, 0, sizeof(_color_hash));
+}
+
+static inline uint16_t color_hash(uint16_t color)
+{
+    return ((color * 0x9E37U) >> 7) & (COLOR_HASH_SIZE - 1);
 }
 
 void Arduino_Canvas_Indexed::begin(int32_t speed)
@@ -20,18 +27,7 @@ void Arduino_Canvas_Indexed::begin(int32_t speed)
     _output->begin(speed);
 
     size_t s = _width * _height;
-#if defined(ESP32)
-    if (psramFound())
-    {
-        _framebuffer = (uint8_t *)ps_malloc(s);
-    }
-    else
-    {
-        _framebuffer = (uint8_t *)malloc(s);
-    }
-#else
-    _framebuffer = (uint8_t *)malloc(s);
-#endif
+    _framebuffer = (uint8_t *)gfx_alloc(s);
     if (!_framebuffer)
     {
         Serial.println(F("_framebuffer allocation failed."));
@@ -127,23 +123,25 @@ void Arduino_Canvas_Indexed::flush()
 
 uint8_t Arduino_Canvas_Indexed::get_color_index(uint16_t color)
 {
-    color &= _color_mask;
-    for (uint8_t i = 0; i < _indexed_size; i++)
+    uint16_t masked = color & _color_mask;
+    uint16_t h = color_hash(masked);
+    uint8_t slot;
+    while ((slot = _color_hash[h]))
     {
-        if (_color_index[i] == color)
+        if (_color_index[slot - 1] == masked)
         {
-            return i;
+            return slot - 1;
         }
+        h = (h + 1) & (COLOR_HASH_SIZE - 1);
     }
-    if (_indexed_size == (COLOR_IDX_SIZE - 1)) // overflowed
+    if ((_indexed_size == (COLOR_IDX_SIZE - 1)) && ((_current_mask_level + 1) < MAXMASKLEVEL)) // overflowed
     {
         raise_mask_level();
+        // the coarser color may be in the palette already
+        return get_color_index(color);
     }
-    _color_index[_indexed_size] = color;
-    // Serial.print("color_index[");
-    // Serial.print(_indexed_size);
-    // Serial.print("] = ");
-    // Serial.println(color);
+    _color_index[_indexed_size] = masked;
+    _color_hash[h] = _indexed_size + 1;
     return _indexed_size++;
 }
 
@@ -158,23 +156,24 @@ void Arduino_Canvas_Indexed::raise_mask_level()
     {
         int32_t buffer_size = _width * _height;
         uint8_t old_indexed_size = _indexed_size;
-        uint8_t new_color;
+        uint8_t remap[COLOR_IDX_SIZE];
         _indexed_size = 0;
+        memset(_color_hash, 0, sizeof(_color_hash));
         _color_mask = mask_level_list[++_current_mask_level];
         Serial.print("Raised mask level: ");
         Serial.println(_current_mask_level);
 
-        // update _framebuffer color index, it is a time consuming job
-        for (uint8_t old_color = 0; old_color < old_indexed_size; old_color++)
+        // the new palette is built in place, entry old_color is read before anything is stored past it
+        for (uint16_t old_color = 0; old_color < old_indexed_size; old_color++)
         {
-            new_color = get_color_index(_color_index[old_color]);
-            for (int32_t i = 0; i < buffer_size; i++)
-            {
-                if (_framebuffer[i] == old_color)
-                {
-                    _framebuffer[i] = new_color;
-                }
-            }
+            remap[old_color] = get_color_index(_color_index[old_color]);
+        }
+        // then a single pass over _framebuffer
+        uint8_t *fb = _framebuffer;
+        for (int32_t i = 0; i < buffer_size; i++)
+        {
+            *fb = remap[*fb];
+            fb++;
         }
     }
 }
@@ -7,6 +7,7 @@
 #include "../Arduino_GFX.h"
 
 #define COLOR_IDX_SIZE 256
+#define COLOR_HASH_SIZE 512 // open addressing, at most half full
 
 class Arduino_Canvas_Indexed : public Arduino_GFX
 {
@@ -28,6 +29,7 @@ protected:
   Arduino_G *_output;
   int16_t _output_x, _output_y;
   uint16_t _color_index[COLOR_IDX_SIZE];
+  uint8_t _color_hash[COLOR_HASH_SIZE]; // palette index + 1, 0 is a free slot
   uint8_t _indexed_size = 0;
   uint8_t _current_mask_level;
   uint16_t _color_mask;
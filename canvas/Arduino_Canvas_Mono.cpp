@@ -2,53 +2,260 @@
 #if !defined(LITTLE_FOOT_PRINT)
 
 #include "../Arduino_GFX.h"
+#include "../Arduino_GFX_Alloc.h"
 #include "Arduino_Canvas_Mono.h"
 
-Arduino_Canvas_Mono::Arduino_Canvas_Mono(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y)
-    : Arduino_GFX(w, h), _output(output), _output_x(output_x), _output_y(output_y)
+#define MONO_SET(color) ((color) & 0b1000010000010000)
+
+Arduino_Canvas_Mono::Arduino_Canvas_Mono(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y, bool verticalByte)
+    : Arduino_GFX(w, h), _output(output), _output_x(output_x), _output_y(output_y),
+      _verticalByte(verticalByte), _page_rows(NULL)
 {
+    _stride = verticalByte ? w : ((w + 7) / 8);
 }
 
 void Arduino_Canvas_Mono::begin(int32_t speed)
 {
-    _output->begin(speed);
+    if (_output)
+    {
+        _output->begin(speed);
+    }
 
-    size_t s = (_width +  7) / 8 * _height;
-#if defined(ESP32)
-    if (psramFound())
+    size_t s = _verticalByte ? (_width * ((_height + 7) / 8)) : (_stride * _height);
+    _framebuffer = (uint8_t *)gfx_alloc(s);
+    if (!_framebuffer)
     {
-        _framebuffer = (uint8_t *)ps_malloc(s);
+        Serial.println(F("_framebuffer allocation failed."));
+        return;
+    }
+    memset(_framebuffer, 0, s);
+
+    if (_verticalByte && _output)
+    {
+        _page_rows = (uint8_t *)gfx_alloc(((_width + 7) / 8) * 8, GFX_MEM_INTERNAL);
+        if (!_page_rows)
+        {
+            Serial.println(F("_page_rows allocation failed."));
+        }
+    }
+}
+
+void Arduino_Canvas_Mono::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
+{
+    uint8_t *p;
+    uint8_t bit;
+    if (_verticalByte)
+    {
+        p = _framebuffer + (int32_t)(y >> 3) * _stride + x;
+        bit = 1 << (y & 7);
     }
     else
     {
-        _framebuffer = (uint8_t *)malloc(s);
+        p = _framebuffer + (int32_t)y * _stride + (x >> 3);
+        bit = 0x80 >> (x & 7);
     }
-#else
-    _framebuffer = (uint8_t *)malloc(s);
-#endif
-    if (!_framebuffer)
+    if (MONO_SET(color))
     {
-        Serial.println(F("_framebuffer allocation failed."));
+        *p |= bit;
+    }
+    else
+    {
+        *p &= ~bit;
     }
 }
 
-void Arduino_Canvas_Mono::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
+void Arduino_Canvas_Mono::writeFastVLine(int16_t x, int16_t y,
+                                         int16_t h, uint16_t color)
+{
+    if (_ordered_in_range(x, 0, _max_x) && h)
+    { // X on screen, nonzero height
+        if (h < 0)
+        {               // If negative height...
+            y += h + 1; //   Move Y to top edge
+            h = -h;     //   Use positive height
+        }
+        if (y <= _max_y)
+        { // Not off bottom
+            int16_t y2 = y + h - 1;
+            if (y2 >= 0)
+            { // Not off top
+                // Line partly or fully overlaps screen
+                if (y < 0)
+                {
+                    y = 0;
+                    h = y2 + 1;
+                } // Clip top
+                if (y2 > _max_y)
+                {
+                    h = _max_y - y + 1;
+                } // Clip bottom
+                writeFillRectPreclipped(x, y, 1, h, color);
+            }
+        }
+    }
+}
+
+void Arduino_Canvas_Mono::writeFastHLine(int16_t x, int16_t y,
+                                         int16_t w, uint16_t color)
+{
+    if (_ordered_in_range(y, 0, _max_y) && w)
+    { // Y on screen, nonzero width
+        if (w < 0)
+        {               // If negative width...
+            x += w + 1; //   Move X to left edge
+            w = -w;     //   Use positive width
+        }
+        if (x <= _max_x)
+        { // Not off right
+            int16_t x2 = x + w - 1;
+            if (x2 >= 0)
+            { // Not off left
+                // Line partly or fully overlaps screen
+                if (x < 0)
+                {
+                    x = 0;
+                    w = x2 + 1;
+                } // Clip left
+                if (x2 > _max_x)
+                {
+                    w = _max_x - x + 1;
+                } // Clip right
+                writeFillRectPreclipped(x, y, w, 1, color);
+            }
+        }
+    }
+}
+
+// set or clear the mask bits in n consecutive bytes, a 32-bit word at a time
+// once p is aligned
+static void mono_fill_masked(uint8_t *p, int16_t n, uint8_t mask, bool set)
 {
-    int16_t w = (_width + 7) / 8;
-    int32_t pos = y * w + x / 8;
-    if (color & 0b1000010000010000)
+    if (mask == 0xFF)
+    {
+        memset(p, set ? 0xFF : 0x00, n);
+        return;
+    }
+    while (n && ((uintptr_t)p & 3))
+    {
+        *p = set ? (*p | mask) : (*p & ~mask);
+        p++;
+        n--;
+    }
+    uint32_t mask32 = mask * 0x01010101UL;
+    uint32_t *p32 = (uint32_t *)p;
+    if (set)
     {
-        _framebuffer[pos] |= 0x80 >> (x & 7);
+        for (; n >= 4; n -= 4)
+        {
+            *p32++ |= mask32;
+        }
     }
     else
     {
-        _framebuffer[pos] &= ~(0x80 >> (x & 7));
+        for (; n >= 4; n -= 4)
+        {
+            *p32++ &= ~mask32;
+        }
+    }
+    p = (uint8_t *)p32;
+    while (n--)
+    {
+        *p = set ? (*p | mask) : (*p & ~mask);
+        p++;
+    }
+}
+
+void Arduino_Canvas_Mono::writeFillRectPreclipped(int16_t x, int16_t y,
+                                                  int16_t w, int16_t h, uint16_t color)
+{
+    bool set = MONO_SET(color);
+    if (_verticalByte)
+    {
+        // one masked run per page, full pages in between are memset
+        int16_t y2 = y + h - 1;
+        int16_t page = y >> 3;
+        int16_t last_page = y2 >> 3;
+        uint8_t *p = _framebuffer + (int32_t)page * _stride + x;
+        for (; page <= last_page; page++)
+        {
+            uint8_t mask = 0xFF;
+            if (page == (y >> 3))
+            {
+                mask &= 0xFF << (y & 7);
+            }
+            if (page == last_page)
+            {
+                mask &= 0xFF >> (7 - (y2 & 7));
+            }
+            mono_fill_masked(p, w, mask, set);
+            p += _stride;
+        }
+    }
+    else
+    {
+        // masked first and last byte, memset in between
+        int16_t x2 = x + w - 1;
+        int16_t bytes = (x2 >> 3) - (x >> 3);
+        uint8_t lmask = 0xFF >> (x & 7);
+        uint8_t rmask = 0xFF << (7 - (x2 & 7));
+        uint8_t *row = _framebuffer + (int32_t)y * _stride + (x >> 3);
+        if (!bytes)
+        {
+            lmask &= rmask;
+        }
+        while (h--)
+        {
+            *row = set ? (*row | lmask) : (*row & ~lmask);
+            if (bytes)
+            {
+                memset(row + 1, set ? 0xFF : 0x00, bytes - 1);
+                row[bytes] = set ? (row[bytes] | rmask) : (row[bytes] & ~rmask);
+            }
+            row += _stride;
+        }
     }
 }
 
 void Arduino_Canvas_Mono::flush()
 {
-    _output->drawBitmap(_output_x, _output_y, _framebuffer, _width, _height, WHITE, BLACK);
+    if (!_output)
+    {
+        return;
+    }
+    if (!_verticalByte)
+    {
+        _output->drawBitmap(_output_x, _output_y, _framebuffer, _width, _height, WHITE, BLACK);
+        return;
+    }
+    if (!_page_rows)
+    {
+        return;
+    }
+    // a page-format canvas is turned back into rows 8 lines at a time
+    int16_t row_bytes = (_width + 7) / 8;
+    uint8_t *page = _framebuffer;
+    for (int16_t y = 0; y < _height; y += 8)
+    {
+        int16_t lines = ((_height - y) < 8) ? (_height - y) : 8;
+        memset(_page_rows, 0, row_bytes * 8);
+        for (int16_t x = 0; x < _width; x++)
+        {
+            uint8_t b = page[x];
+            uint8_t bit = 0x80 >> (x & 7);
+            uint8_t *r = _page_rows + (x >> 3);
+            while (b)
+            {
+                if (b & 1)
+                {
+                    *r |= bit;
+                }
+                b >>= 1;
+                r += row_bytes;
+            }
+        }
+        _output->drawBitmap(_output_x, _output_y + y, _page_rows, _width, lines, WHITE, BLACK);
+        page += _stride;
+    }
 }
 
 #endif // !defined(LITTLE_FOOT_PRINT)
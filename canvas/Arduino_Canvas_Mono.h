@@ -9,16 +9,27 @@
 class Arduino_Canvas_Mono : public Arduino_GFX
 {
 public:
-  Arduino_Canvas_Mono(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0);
+  // verticalByte stores 8 rows per byte, LSB on top, in the page format of
+  // SSD1306/SH1106 RAM; output may be NULL when getFramebuffer() is copied
+  // to such a display directly
+  Arduino_Canvas_Mono(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0, bool verticalByte = false);
 
   void begin(int32_t speed = GFX_NOT_DEFINED) override;
   void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
   void flush(void) override;
 
+  uint8_t *getFramebuffer() { return _framebuffer; }
+
 protected:
   uint8_t *_framebuffer;
   Arduino_G *_output;
   int16_t _output_x, _output_y;
+  bool _verticalByte;
+  int16_t _stride;      // bytes per row, or per page with verticalByte
+  uint8_t *_page_rows;  // one page turned back into 8 rows for flush()
 
 private:
 };
@@ -0,0 +1,316 @@
+#include "../Arduino_DataBus.h"
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas_RLE.h"
+
+Arduino_Canvas_RLE::Arduino_Canvas_RLE(int16_t w, int16_t h, Arduino_TFT *output, int16_t output_x, int16_t output_y, uint16_t initial_runs)
+    : Arduino_GFX(w, h), _output(output), _output_x(output_x), _output_y(output_y),
+      _rows(NULL), _runs(NULL), _runs_size(h + initial_runs), _runs_used(0), _free_run(RLE_CANVAS_NO_RUN),
+      _dirty_rows(NULL), _dirty_x1(0), _dirty_x2(w), _overflowed(false)
+{
+}
+
+void Arduino_Canvas_RLE::begin(int32_t speed)
+{
+    _output->begin(speed);
+
+    _rows = (uint16_t *)malloc(_height * sizeof(uint16_t));
+    _runs = (gfx_rle_run_t *)malloc(_runs_size * sizeof(gfx_rle_run_t));
+    _dirty_rows = (uint8_t *)malloc((_height + 7) / 8);
+    if ((!_rows) || (!_runs) || (!_dirty_rows))
+    {
+        Serial.println(F("RLE canvas allocation failed."));
+        return;
+    }
+
+    // every row starts as a single black run
+    for (uint16_t i = 0; i < _runs_size; i++)
+    {
+        _runs[i].next = i + 1;
+    }
+    _runs[_runs_size - 1].next = RLE_CANVAS_NO_RUN;
+    _free_run = 0;
+    for (int16_t y = 0; y < _height; y++)
+    {
+        uint16_t r = allocRun();
+        _runs[r].x = 0;
+        _runs[r].color = BLACK;
+        _runs[r].next = RLE_CANVAS_NO_RUN;
+        _rows[y] = r;
+    }
+    memset(_dirty_rows, 0xFF, (_height + 7) / 8);
+}
+
+uint16_t Arduino_Canvas_RLE::allocRun()
+{
+    uint16_t idx = _free_run;
+    _free_run = _runs[idx].next;
+    _runs_used++;
+    return idx;
+}
+
+void Arduino_Canvas_RLE::freeRun(uint16_t idx)
+{
+    _runs[idx].next = _free_run;
+    _free_run = idx;
+    _runs_used--;
+}
+
+bool Arduino_Canvas_RLE::reserveRuns(uint8_t n)
+{
+    if ((uint16_t)(_runs_size - _runs_used) >= n)
+    {
+        return true;
+    }
+    uint32_t new_size = (uint32_t)_runs_size + RLE_CANVAS_GROW_RUNS;
+    if (new_size >= RLE_CANVAS_NO_RUN)
+    {
+        new_size = RLE_CANVAS_NO_RUN - 1;
+    }
+    gfx_rle_run_t *runs = NULL;
+    if (new_size > _runs_size)
+    {
+        runs = (gfx_rle_run_t *)realloc(_runs, new_size * sizeof(gfx_rle_run_t));
+    }
+    if (!runs)
+    {
+        if (!_overflowed)
+        {
+            Serial.println(F("RLE canvas out of memory, dropping draw calls."));
+        }
+        _overflowed = true;
+        return false;
+    }
+    _runs = runs;
+    for (uint16_t i = _runs_size; i < new_size; i++)
+    {
+        _runs[i].next = _free_run;
+        _free_run = i;
+    }
+    _runs_size = new_size;
+    return (uint16_t)(_runs_size - _runs_used) >= n;
+}
+
+// Paints [x1, x2) of row y, splitting the runs at both ends and merging
+// neighbours of the same colour
+void Arduino_Canvas_RLE::fillSpan(int16_t y, int16_t x1, int16_t x2, uint16_t color)
+{
+    uint16_t prev = RLE_CANVAS_NO_RUN;
+    uint16_t cur = _rows[y];
+    uint16_t next;
+    while (((next = _runs[cur].next) != RLE_CANVAS_NO_RUN) && (_runs[next].x <= x1))
+    {
+        prev = cur;
+        cur = next;
+    }
+    if ((_runs[cur].color == color) && ((next == RLE_CANVAS_NO_RUN) || (_runs[next].x >= x2)))
+    {
+        return; // already that colour
+    }
+    if (!reserveRuns(2))
+    {
+        return;
+    }
+    _dirty_rows[y >> 3] |= 1 << (y & 7);
+    if (x1 < _dirty_x1)
+    {
+        _dirty_x1 = x1;
+    }
+    if (x2 > _dirty_x2)
+    {
+        _dirty_x2 = x2;
+    }
+
+    if (_runs[cur].x < x1)
+    {
+        // keep the head of cur, the span starts in a new run
+        uint16_t r = allocRun();
+        _runs[r].x = x1;
+        _runs[r].color = _runs[cur].color;
+        _runs[r].next = _runs[cur].next;
+        _runs[cur].next = r;
+        prev = cur;
+        cur = r;
+    }
+
+    // drop the runs starting inside the span, the last one's tail survives
+    uint16_t tail_color = _runs[cur].color;
+    next = _runs[cur].next;
+    while ((next != RLE_CANVAS_NO_RUN) && (_runs[next].x < x2))
+    {
+        uint16_t n = _runs[next].next;
+        tail_color = _runs[next].color;
+        freeRun(next);
+        next = n;
+    }
+    if ((x2 < _width) && ((next == RLE_CANVAS_NO_RUN) || (_runs[next].x > x2)))
+    {
+        uint16_t r = allocRun();
+        _runs[r].x = x2;
+        _runs[r].color = tail_color;
+        _runs[r].next = next;
+        next = r;
+    }
+    _runs[cur].color = color;
+    _runs[cur].next = next;
+
+    if ((next != RLE_CANVAS_NO_RUN) && (_runs[next].color == color))
+    {
+        _runs[cur].next = _runs[next].next;
+        freeRun(next);
+    }
+    if ((prev != RLE_CANVAS_NO_RUN) && (_runs[prev].color == color))
+    {
+        _runs[prev].next = _runs[cur].next;
+        freeRun(cur);
+    }
+}
+
+void Arduino_Canvas_RLE::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
+{
+    fillSpan(y, x, x + 1, color);
+}
+
+void Arduino_Canvas_RLE::writeFastVLine(int16_t x, int16_t y,
+                                        int16_t h, uint16_t color)
+{
+    if (_ordered_in_range(x, 0, _max_x) && h)
+    { // X on screen, nonzero height
+        if (h < 0)
+        {               // If negative height...
+            y += h + 1; //   Move Y to top edge
+            h = -h;     //   Use positive height
+        }
+        if (y <= _max_y)
+        { // Not off bottom
+            int16_t y2 = y + h - 1;
+            if (y2 >= 0)
+            { // Not off top
+                // Line partly or fully overlaps screen
+                if (y < 0)
+                {
+                    y = 0;
+                    h = y2 + 1;
+                } // Clip top
+                if (y2 > _max_y)
+                {
+                    h = _max_y - y + 1;
+                } // Clip bottom
+                writeFillRectPreclipped(x, y, 1, h, color);
+            }
+        }
+    }
+}
+
+void Arduino_Canvas_RLE::writeFastHLine(int16_t x, int16_t y,
+                                        int16_t w, uint16_t color)
+{
+    if (_ordered_in_range(y, 0, _max_y) && w)
+    { // Y on screen, nonzero width
+        if (w < 0)
+        {               // If negative width...
+            x += w + 1; //   Move X to left edge
+            w = -w;     //   Use positive width
+        }
+        if (x <= _max_x)
+        { // Not off right
+            int16_t x2 = x + w - 1;
+            if (x2 >= 0)
+            { // Not off left
+                // Line partly or fully overlaps screen
+                if (x < 0)
+                {
+                    x = 0;
+                    w = x2 + 1;
+                } // Clip left
+                if (x2 > _max_x)
+                {
+                    w = _max_x - x + 1;
+                } // Clip right
+                fillSpan(y, x, x + w, color);
+            }
+        }
+    }
+}
+
+void Arduino_Canvas_RLE::writeFillRectPreclipped(int16_t x, int16_t y,
+                                                 int16_t w, int16_t h, uint16_t color)
+{
+    while (h--)
+    {
+        fillSpan(y++, x, x + w, color);
+    }
+}
+
+uint16_t Arduino_Canvas_RLE::getPixel(int16_t x, int16_t y)
+{
+    uint16_t cur = _rows[y];
+    uint16_t next;
+    while (((next = _runs[cur].next) != RLE_CANVAS_NO_RUN) && (_runs[next].x <= x))
+    {
+        cur = next;
+    }
+    return _runs[cur].color;
+}
+
+size_t Arduino_Canvas_RLE::getMemoryUsage()
+{
+    return (_height * sizeof(uint16_t)) + (_runs_size * sizeof(gfx_rle_run_t)) + ((_height + 7) / 8);
+}
+
+void Arduino_Canvas_RLE::flush()
+{
+    int16_t y = 0;
+    _output->startWrite();
+    while (y < _height)
+    {
+        if (!(_dirty_rows[y >> 3] & (1 << (y & 7))))
+        {
+            y++;
+            continue;
+        }
+        // one address window per band of changed rows
+        int16_t y2 = y;
+        while ((y2 < _height) && (_dirty_rows[y2 >> 3] & (1 << (y2 & 7))))
+        {
+            y2++;
+        }
+        _output->writeAddrWindow(_output_x + _dirty_x1, _output_y + y, _dirty_x2 - _dirty_x1, y2 - y);
+
+        // a run reaching the end of a row continues into the next one
+        uint16_t color = _runs[_rows[y]].color;
+        uint32_t len = 0;
+        for (; y < y2; y++)
+        {
+            uint16_t cur = _rows[y];
+            while (cur != RLE_CANVAS_NO_RUN)
+            {
+                uint16_t next = _runs[cur].next;
+                int16_t start = (_runs[cur].x > _dirty_x1) ? _runs[cur].x : _dirty_x1;
+                int16_t end = (next == RLE_CANVAS_NO_RUN) ? _width : _runs[next].x;
+                if (end > _dirty_x2)
+                {
+                    end = _dirty_x2;
+                }
+                if (start < end)
+                {
+                    if (_runs[cur].color != color)
+                    {
+                        if (len)
+                        {
+                            _output->writeRepeat(color, len);
+                        }
+                        color = _runs[cur].color;
+                        len = 0;
+                    }
+                    len += end - start;
+                }
+                cur = next;
+            }
+        }
+        _output->writeRepeat(color, len);
+    }
+    _output->endWrite();
+    memset(_dirty_rows, 0, (_height + 7) / 8);
+    _dirty_x1 = _width;
+    _dirty_x2 = 0;
+}
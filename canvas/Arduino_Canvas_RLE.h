@@ -0,0 +1,68 @@
+#ifndef _ARDUINO_CANVAS_RLE_H_
+#define _ARDUINO_CANVAS_RLE_H_
+
+#include "../Arduino_DataBus.h"
+#include "../Arduino_GFX.h"
+#include "../Arduino_TFT.h"
+
+#ifndef RLE_CANVAS_INITIAL_RUNS
+#if defined(LITTLE_FOOT_PRINT)
+#define RLE_CANVAS_INITIAL_RUNS 0 // one run per row, grown as the scene needs
+#else
+#define RLE_CANVAS_INITIAL_RUNS 512
+#endif
+#endif
+#ifndef RLE_CANVAS_GROW_RUNS
+#define RLE_CANVAS_GROW_RUNS 64 // runs added each time the pool is full
+#endif
+
+#define RLE_CANVAS_NO_RUN 0xFFFF
+
+typedef struct
+{
+  uint16_t x; // first pixel, the run ends where the next one starts
+  uint16_t color;
+  uint16_t next;
+} gfx_rle_run_t;
+
+// Keeps every row as a linked list of single colour runs, so memory follows
+// the number of colour changes in the scene instead of its resolution.
+// flush() sends the changed rows and columns as writeRepeat() calls.
+class Arduino_Canvas_RLE : public Arduino_GFX
+{
+public:
+  Arduino_Canvas_RLE(int16_t w, int16_t h, Arduino_TFT *output, int16_t output_x = 0, int16_t output_y = 0, uint16_t initial_runs = RLE_CANVAS_INITIAL_RUNS);
+
+  void begin(int32_t speed = GFX_NOT_DEFINED) override;
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void flush(void) override;
+
+  uint16_t getPixel(int16_t x, int16_t y);
+  uint16_t getRunCount() { return _runs_used; }
+  size_t getMemoryUsage(); // bytes held by the row heads, run pool and dirty rows
+  bool isOverflowed() { return _overflowed; } // a draw call was dropped for lack of memory
+
+protected:
+  void fillSpan(int16_t y, int16_t x1, int16_t x2, uint16_t color);
+  uint16_t allocRun();
+  void freeRun(uint16_t idx);
+  bool reserveRuns(uint8_t n);
+
+  Arduino_TFT *_output;
+  int16_t _output_x, _output_y;
+  uint16_t *_rows;       // first run of each row
+  gfx_rle_run_t *_runs;  // pool, linked by index so it can be reallocated
+  uint16_t _runs_size;
+  uint16_t _runs_used;
+  uint16_t _free_run;
+  uint8_t *_dirty_rows;  // one bit per row changed since the last flush()
+  int16_t _dirty_x1, _dirty_x2; // columns changed since the last flush()
+  bool _overflowed;
+
+private:
+};
+
+#endif // _ARDUINO_CANVAS_RLE_H_
@@ -0,0 +1,70 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas_Strip.h"
+
+Arduino_Canvas_Strip::Arduino_Canvas_Strip(
+    int16_t w, int16_t h, int16_t strip_rows, Arduino_G *output, int16_t output_x, int16_t output_y, bool big_endian)
+    : Arduino_Canvas_Window(w, h, (int32_t)w * strip_rows, output, output_x, output_y, big_endian),
+      _strip_rows(strip_rows), _frame_time(0)
+{
+}
+
+// strip height can be lowered at run time, up to the height the buffer was allocated for
+void Arduino_Canvas_Strip::setStripRows(int16_t strip_rows)
+{
+    int16_t max_rows = _buffer_pixels / _width;
+    if (strip_rows > max_rows)
+    {
+        strip_rows = max_rows;
+    }
+    if (strip_rows < 1)
+    {
+        strip_rows = 1;
+    }
+    _strip_rows = strip_rows;
+}
+
+void Arduino_Canvas_Strip::render(gfx_draw_callback_t scene, void *arg)
+{
+    uint32_t start = micros();
+    for (int16_t y = 0; y < _height; y += _strip_rows)
+    {
+        setWindow(0, y, _width, _strip_rows);
+        scene(this, arg);
+        flush();
+    }
+    _frame_time = micros() - start;
+}
+
+void Arduino_Canvas_Strip::render(Arduino_DisplayList *list)
+{
+    uint32_t start = micros();
+    for (int16_t y = 0; y < _height; y += _strip_rows)
+    {
+        setWindow(0, y, _width, _strip_rows);
+        list->replay(this, 0, y, _width, _strip_rows);
+        flush();
+    }
+    _frame_time = micros() - start;
+}
+
+// redraw part of the screen, e.g. a rectangle from Arduino_DisplayList::diff()
+void Arduino_Canvas_Strip::renderRect(Arduino_DisplayList *list, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    if (w <= 0)
+    {
+        return;
+    }
+    int16_t rows = _buffer_pixels / w;
+    for (int16_t by = y; by < y + h; by += rows)
+    {
+        int16_t bh = ((y + h - by) < rows) ? (y + h - by) : rows;
+        setWindow(x, by, w, bh);
+        list->replay(this, x, by, w, bh);
+        flush();
+    }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
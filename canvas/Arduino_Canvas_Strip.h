@@ -0,0 +1,33 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_CANVAS_STRIP_H_
+#define _ARDUINO_CANVAS_STRIP_H_
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas_Window.h"
+#include "Arduino_DisplayList.h"
+
+// Renders a w x h scene a few full width rows at a time, buffering w * strip_rows pixels
+class Arduino_Canvas_Strip : public Arduino_Canvas_Window
+{
+public:
+  Arduino_Canvas_Strip(int16_t w, int16_t h, int16_t strip_rows, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0, bool big_endian = false);
+
+  void render(gfx_draw_callback_t scene, void *arg = NULL);
+  void render(Arduino_DisplayList *list);
+  void renderRect(Arduino_DisplayList *list, int16_t x, int16_t y, int16_t w, int16_t h);
+  void setStripRows(int16_t strip_rows);
+  int16_t getStripRows() { return _strip_rows; }
+  uint32_t getFrameTime() { return _frame_time; }
+
+protected:
+  int16_t _strip_rows;
+  uint32_t _frame_time;
+
+private:
+};
+
+#endif // _ARDUINO_CANVAS_STRIP_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,218 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "../Arduino_GFX_Alloc.h"
+#include "Arduino_Canvas_Window.h"
+
+Arduino_Canvas_Window::Arduino_Canvas_Window(
+    int16_t w, int16_t h, int32_t buffer_pixels, Arduino_G *output, int16_t output_x, int16_t output_y, bool big_endian)
+    : Arduino_GFX(w, h), _framebuffer(NULL), _buffer_pixels(buffer_pixels),
+      _output(output), _output_x(output_x), _output_y(output_y), _big_endian(big_endian)
+{
+    _win_x = _win_y = 0;
+    _win_w = _win_h = 0;
+    _win_x2 = _win_y2 = -1;
+}
+
+void Arduino_Canvas_Window::begin(int32_t speed)
+{
+    _output->begin(speed);
+
+    size_t s = _buffer_pixels * 2;
+    _framebuffer = (uint16_t *)gfx_alloc(s);
+    if (!_framebuffer)
+    {
+        Serial.println(F("_framebuffer allocation failed."));
+    }
+}
+
+bool Arduino_Canvas_Window::setWindow(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    int16_t x2 = x + w - 1;
+    int16_t y2 = y + h - 1;
+    if (x < 0)
+    {
+        x = 0;
+    }
+    if (y < 0)
+    {
+        y = 0;
+    }
+    if (x2 > _max_x)
+    {
+        x2 = _max_x;
+    }
+    if (y2 > _max_y)
+    {
+        y2 = _max_y;
+    }
+    w = x2 - x + 1;
+    h = y2 - y + 1;
+    if ((w <= 0) || (h <= 0) || ((int32_t)w * h > _buffer_pixels))
+    {
+        _win_w = _win_h = 0;
+        _win_x2 = _win_y2 = -1;
+        return false;
+    }
+    _win_x = x;
+    _win_y = y;
+    _win_w = w;
+    _win_h = h;
+    _win_x2 = x2;
+    _win_y2 = y2;
+    return true;
+}
+
+void Arduino_Canvas_Window::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
+{
+    if (_ordered_in_range(x, _win_x, _win_x2) && _ordered_in_range(y, _win_y, _win_y2))
+    {
+        if (_big_endian)
+        {
+            MSB_16_SET(color, color);
+        }
+        _framebuffer[((int32_t)(y - _win_y) * _win_w) + (x - _win_x)] = color;
+    }
+}
+
+void Arduino_Canvas_Window::writeFastVLine(int16_t x, int16_t y,
+                                           int16_t h, uint16_t color)
+{
+    if (h < 0)
+    {
+        y += h + 1;
+        h = -h;
+    }
+    writeFillRectPreclipped(x, y, 1, h, color);
+}
+
+void Arduino_Canvas_Window::writeFastHLine(int16_t x, int16_t y,
+                                           int16_t w, uint16_t color)
+{
+    if (w < 0)
+    {
+        x += w + 1;
+        w = -w;
+    }
+    writeFillRectPreclipped(x, y, w, 1, color);
+}
+
+void Arduino_Canvas_Window::writeFillRectPreclipped(int16_t x, int16_t y,
+                                                    int16_t w, int16_t h, uint16_t color)
+{
+    int16_t x2 = x + w - 1;
+    int16_t y2 = y + h - 1;
+    if ((x > _win_x2) || (y > _win_y2) || (x2 < _win_x) || (y2 < _win_y))
+    {
+        return;
+    }
+    if (x < _win_x)
+    {
+        x = _win_x;
+    }
+    if (y < _win_y)
+    {
+        y = _win_y;
+    }
+    if (x2 > _win_x2)
+    {
+        x2 = _win_x2;
+    }
+    if (y2 > _win_y2)
+    {
+        y2 = _win_y2;
+    }
+    w = x2 - x + 1;
+    h = y2 - y + 1;
+
+    if (_big_endian)
+    {
+        MSB_16_SET(color, color);
+    }
+    uint16_t *row = _framebuffer + ((int32_t)(y - _win_y) * _win_w) + (x - _win_x);
+    for (int j = 0; j < h; j++)
+    {
+        for (int i = 0; i < w; i++)
+        {
+            row[i] = color;
+        }
+        row += _win_w;
+    }
+}
+
+void Arduino_Canvas_Window::draw16bitRGBBitmap(int16_t x, int16_t y,
+                                               uint16_t *bitmap, int16_t w, int16_t h)
+{
+    copyBitmap(x, y, bitmap, w, h, _big_endian);
+}
+
+void Arduino_Canvas_Window::draw16bitBeRGBBitmap(int16_t x, int16_t y,
+                                                 uint16_t *bitmap, int16_t w, int16_t h)
+{
+    copyBitmap(x, y, bitmap, w, h, !_big_endian);
+}
+
+void Arduino_Canvas_Window::copyBitmap(int16_t x, int16_t y,
+                                       uint16_t *bitmap, int16_t w, int16_t h, bool swap)
+{
+    int16_t x2 = x + w - 1;
+    int16_t y2 = y + h - 1;
+    if ((x > _win_x2) || (y > _win_y2) || (x2 < _win_x) || (y2 < _win_y))
+    {
+        return;
+    }
+    int16_t stride = w;
+    if (y < _win_y)
+    {
+        bitmap += (int32_t)(_win_y - y) * stride;
+        y = _win_y;
+    }
+    if (x < _win_x)
+    {
+        bitmap += _win_x - x;
+        x = _win_x;
+    }
+    if (x2 > _win_x2)
+    {
+        x2 = _win_x2;
+    }
+    if (y2 > _win_y2)
+    {
+        y2 = _win_y2;
+    }
+    w = x2 - x + 1;
+    h = y2 - y + 1;
+
+    uint16_t *row = _framebuffer + ((int32_t)(y - _win_y) * _win_w) + (x - _win_x);
+    for (int j = 0; j < h; j++)
+    {
+        if (swap)
+        {
+            Arduino_DataBus::swapPixels(row, bitmap, w);
+        }
+        else
+        {
+            memcpy(row, bitmap, w * 2);
+        }
+        bitmap += stride;
+        row += _win_w;
+    }
+}
+
+void Arduino_Canvas_Window::flush()
+{
+    if ((_win_w > 0) && (_win_h > 0))
+    {
+        if (_big_endian)
+        {
+            _output->draw16bitBeRGBBitmap(_output_x + _win_x, _output_y + _win_y, _framebuffer, _win_w, _win_h);
+        }
+        else
+        {
+            _output->draw16bitRGBBitmap(_output_x + _win_x, _output_y + _win_y, _framebuffer, _win_w, _win_h);
+        }
+    }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,51 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_CANVAS_WINDOW_H_
+#define _ARDUINO_CANVAS_WINDOW_H_
+
+#include "../Arduino_GFX.h"
+
+// Scene or sprite renderer, draws in screen coordinates and is clipped to the window
+typedef void (*gfx_draw_callback_t)(Arduino_GFX *gfx, void *arg);
+
+// A canvas covering a movable window of a w x h screen, only the window is buffered
+class Arduino_Canvas_Window : public Arduino_GFX
+{
+public:
+  Arduino_Canvas_Window(int16_t w, int16_t h, int32_t buffer_pixels, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0, bool big_endian = false);
+
+  void begin(int32_t speed = GFX_NOT_DEFINED) override;
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void flush(void) override;
+
+  // clipped to the screen, false if it does not fit the buffer or is offscreen
+  bool setWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+  int32_t getBufferPixels() { return _buffer_pixels; }
+  uint16_t *getFramebuffer() { return _framebuffer; }
+  Arduino_G *getOutput() { return _output; }
+  int16_t getOutputX() { return _output_x; } // where screen (0, 0) lands on the output
+  int16_t getOutputY() { return _output_y; }
+  bool isBigEndian() { return _big_endian; }
+
+protected:
+  uint16_t *_framebuffer;
+  int32_t _buffer_pixels;
+  Arduino_G *_output;
+  int16_t _output_x, _output_y;
+  int16_t _win_x, _win_y, _win_w, _win_h, _win_x2, _win_y2;
+  bool _big_endian;
+
+  void copyBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, bool swap);
+
+private:
+};
+
+#endif // _ARDUINO_CANVAS_WINDOW_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
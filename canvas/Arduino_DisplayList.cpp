@@ -0,0 +1,331 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "../Arduino_GFX_Alloc.h"
+#include "Arduino_DisplayList.h"
+
+#define DL_MAX_ARGS 6
+
+Arduino_DisplayList::Arduino_DisplayList(int16_t w, int16_t h, size_t size)
+    : Arduino_GFX(w, h), _buffer(NULL), _size(size), _length(0), _overflow(false)
+{
+}
+
+void Arduino_DisplayList::begin(int32_t speed)
+{
+    UNUSED(speed);
+
+    _buffer = (uint8_t *)gfx_alloc(_size, GFX_MEM_INTERNAL);
+    if (!_buffer)
+    {
+        Serial.println(F("_buffer allocation failed."));
+        _size = 0;
+    }
+}
+
+void Arduino_DisplayList::clear()
+{
+    _length = 0;
+    _overflow = false;
+}
+
+size_t Arduino_DisplayList::opSize(uint8_t op)
+{
+    switch (op)
+    {
+    case DL_PIXEL:
+        return 1 + (3 * 2);
+    case DL_HLINE:
+    case DL_VLINE:
+        return 1 + (4 * 2);
+    case DL_RECT:
+    case DL_LINE:
+        return 1 + (5 * 2);
+    case DL_AALINE:
+        return 1 + (6 * 2);
+    }
+    return 1;
+}
+
+void Arduino_DisplayList::record(uint8_t op, uint8_t argc, const int16_t *args)
+{
+    size_t len = 1 + (argc * 2);
+    if (_length + len > _size)
+    {
+        if (!_overflow)
+        {
+            Serial.println(F("Display list full."));
+            _overflow = true;
+        }
+        return;
+    }
+    uint8_t *p = _buffer + _length;
+    *p++ = op;
+    memcpy(p, args, argc * 2);
+    _length += len;
+}
+
+void Arduino_DisplayList::opArgs(const uint8_t *p, int16_t *args)
+{
+    memcpy(args, p + 1, opSize(*p) - 1);
+}
+
+void Arduino_DisplayList::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
+{
+    int16_t args[] = {x, y, (int16_t)color};
+    record(DL_PIXEL, 3, args);
+}
+
+void Arduino_DisplayList::writeFastVLine(int16_t x, int16_t y,
+                                         int16_t h, uint16_t color)
+{
+    if (h < 0)
+    {
+        y += h + 1;
+        h = -h;
+    }
+    if (h)
+    {
+        int16_t args[] = {x, y, h, (int16_t)color};
+        record(DL_VLINE, 4, args);
+    }
+}
+
+void Arduino_DisplayList::writeFastHLine(int16_t x, int16_t y,
+                                         int16_t w, uint16_t color)
+{
+    if (w < 0)
+    {
+        x += w + 1;
+        w = -w;
+    }
+    if (w)
+    {
+        int16_t args[] = {x, y, w, (int16_t)color};
+        record(DL_HLINE, 4, args);
+    }
+}
+
+void Arduino_DisplayList::writeFillRectPreclipped(int16_t x, int16_t y,
+                                                  int16_t w, int16_t h, uint16_t color)
+{
+    int16_t args[] = {x, y, w, h, (int16_t)color};
+    record(DL_RECT, 5, args);
+}
+
+void Arduino_DisplayList::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                    uint16_t color)
+{
+    int16_t args[] = {x0, y0, x1, y1, (int16_t)color};
+    record(DL_LINE, 5, args);
+}
+
+void Arduino_DisplayList::writeAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                               uint16_t color, uint16_t bg)
+{
+    int16_t args[] = {x0, y0, x1, y1, (int16_t)color, (int16_t)bg};
+    record(DL_AALINE, 6, args);
+}
+
+// bounding box of the pixels an op can touch, false if it is entirely offscreen
+bool Arduino_DisplayList::opBounds(const uint8_t *p, gfx_rect_t *r)
+{
+    int16_t a[DL_MAX_ARGS];
+    opArgs(p, a);
+    switch (*p)
+    {
+    case DL_PIXEL:
+        r->x = a[0];
+        r->y = a[1];
+        r->w = r->h = 1;
+        break;
+    case DL_HLINE:
+        r->x = a[0];
+        r->y = a[1];
+        r->w = a[2];
+        r->h = 1;
+        break;
+    case DL_VLINE:
+        r->x = a[0];
+        r->y = a[1];
+        r->w = 1;
+        r->h = a[2];
+        break;
+    case DL_RECT:
+        r->x = a[0];
+        r->y = a[1];
+        r->w = a[2];
+        r->h = a[3];
+        break;
+    case DL_LINE:
+    case DL_AALINE:
+        r->x = (a[0] < a[2]) ? a[0] : a[2];
+        r->y = (a[1] < a[3]) ? a[1] : a[3];
+        r->w = _diff(a[0], a[2]) + 1;
+        r->h = _diff(a[1], a[3]) + 1;
+        if (*p == DL_AALINE)
+        {
+            // coverage spills one pixel below or right of the ideal line
+            r->w++;
+            r->h++;
+        }
+        break;
+    default:
+        return false;
+    }
+
+    int16_t x2 = r->x + r->w;
+    int16_t y2 = r->y + r->h;
+    if (r->x < 0)
+    {
+        r->x = 0;
+    }
+    if (r->y < 0)
+    {
+        r->y = 0;
+    }
+    if (x2 > _width)
+    {
+        x2 = _width;
+    }
+    if (y2 > _height)
+    {
+        y2 = _height;
+    }
+    r->w = x2 - r->x;
+    r->h = y2 - r->y;
+    return (r->w > 0) && (r->h > 0);
+}
+
+void Arduino_DisplayList::replay(Arduino_GFX *out)
+{
+    replay(out, 0, 0, _width, _height);
+}
+
+// replay only the ops that touch the clip rectangle
+void Arduino_DisplayList::replay(Arduino_GFX *out, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    int16_t a[DL_MAX_ARGS];
+    gfx_rect_t r;
+    const uint8_t *p = _buffer;
+    const uint8_t *end = _buffer + _length;
+
+    out->startWrite();
+    while (p < end)
+    {
+        if (opBounds(p, &r) &&
+            (r.x < x + w) && (r.x + r.w > x) &&
+            (r.y < y + h) && (r.y + r.h > y))
+        {
+            opArgs(p, a);
+            switch (*p)
+            {
+            case DL_PIXEL:
+                out->writePixel(a[0], a[1], a[2]);
+                break;
+            case DL_HLINE:
+                out->writeFastHLine(a[0], a[1], a[2], a[3]);
+                break;
+            case DL_VLINE:
+                out->writeFastVLine(a[0], a[1], a[2], a[3]);
+                break;
+            case DL_RECT:
+                out->writeFillRect(a[0], a[1], a[2], a[3], a[4]);
+                break;
+            case DL_LINE:
+                out->writeLine(a[0], a[1], a[2], a[3], a[4]);
+                break;
+            case DL_AALINE:
+                out->writeAntialiasedLine(a[0], a[1], a[2], a[3], a[4], a[5]);
+                break;
+            }
+        }
+        p += opSize(*p);
+    }
+    out->endWrite();
+}
+
+/*!
+  @brief  Find the screen areas that differ between this list and prev.
+          Ops shared at the start and end of both lists are skipped, the
+          bounds of every op in between, in either list, are merged into
+          at most max_rects rectangles. Replaying this list clipped to
+          each rectangle turns the screen showing prev into this list.
+  @return number of rectangles written to rects
+*/
+uint8_t Arduino_DisplayList::diff(Arduino_DisplayList *prev, gfx_rect_t *rects, uint8_t max_rects)
+{
+    uint8_t count = 0;
+    if (max_rects == 0)
+    {
+        return 0;
+    }
+    if (_overflow || prev->_overflow)
+    {
+        // an incomplete list can not be compared, redraw everything
+        rects[0].x = rects[0].y = 0;
+        rects[0].w = _width;
+        rects[0].h = _height;
+        return 1;
+    }
+
+    // common leading ops
+    size_t head = 0;
+    while ((head < _length) && (head < prev->_length))
+    {
+        size_t s = opSize(_buffer[head]);
+        if ((head + s > prev->_length) || memcmp(_buffer + head, prev->_buffer + head, s))
+        {
+            break;
+        }
+        head += s;
+    }
+
+    // common trailing bytes, then the longest tail starting on an op boundary in both lists
+    size_t tail = 0;
+    while ((tail < _length - head) && (tail < prev->_length - head) &&
+           (_buffer[_length - 1 - tail] == prev->_buffer[prev->_length - 1 - tail]))
+    {
+        tail++;
+    }
+    size_t a = head, b = head;
+    size_t end = _length, prev_end = prev->_length;
+    while ((a < _length) && (b < prev->_length))
+    {
+        size_t ta = _length - a, tb = prev->_length - b;
+        if ((ta == tb) && (ta <= tail))
+        {
+            end = a;
+            prev_end = b;
+            break;
+        }
+        if (ta >= tb)
+        {
+            a += opSize(_buffer[a]);
+        }
+        else
+        {
+            b += prev->opSize(prev->_buffer[b]);
+        }
+    }
+
+    gfx_rect_t r;
+    for (size_t i = head; i < end; i += opSize(_buffer[i]))
+    {
+        if (opBounds(_buffer + i, &r))
+        {
+            gfx_add_rect(rects, &count, max_rects, &r);
+        }
+    }
+    for (size_t i = head; i < prev_end; i += opSize(prev->_buffer[i]))
+    {
+        if (prev->opBounds(prev->_buffer + i, &r))
+        {
+            gfx_add_rect(rects, &count, max_rects, &r);
+        }
+    }
+    return count;
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,61 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_DISPLAYLIST_H_
+#define _ARDUINO_DISPLAYLIST_H_
+
+#include "../Arduino_GFX.h"
+
+#ifndef DISPLAYLIST_DEFAULT_SIZE
+#define DISPLAYLIST_DEFAULT_SIZE 2048
+#endif
+
+enum
+{
+  DL_PIXEL = 1, // x, y, color
+  DL_HLINE,     // x, y, w, color
+  DL_VLINE,     // x, y, h, color
+  DL_RECT,      // x, y, w, h, color
+  DL_LINE,      // x0, y0, x1, y1, color
+  DL_AALINE,    // x0, y0, x1, y1, color, bg
+};
+
+// Records primitives into a compact buffer instead of drawing them, for replay to any output
+class Arduino_DisplayList : public Arduino_GFX
+{
+public:
+  Arduino_DisplayList(int16_t w, int16_t h, size_t size = DISPLAYLIST_DEFAULT_SIZE);
+
+  void begin(int32_t speed = GFX_NOT_DEFINED) override;
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
+  void writeAntialiasedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint16_t bg) override;
+
+  void clear();
+  void replay(Arduino_GFX *out);
+  void replay(Arduino_GFX *out, int16_t x, int16_t y, int16_t w, int16_t h);
+  uint8_t diff(Arduino_DisplayList *prev, gfx_rect_t *rects, uint8_t max_rects);
+
+  size_t getLength() { return _length; }
+  bool isOverflow() { return _overflow; }
+
+protected:
+  void record(uint8_t op, uint8_t argc, const int16_t *args);
+  size_t opSize(uint8_t op);
+  void opArgs(const uint8_t *p, int16_t *args);
+  bool opBounds(const uint8_t *p, gfx_rect_t *r);
+
+  uint8_t *_buffer;
+  size_t _size;
+  size_t _length;
+  bool _overflow;
+
+private:
+};
+
+#endif // _ARDUINO_DISPLAYLIST_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
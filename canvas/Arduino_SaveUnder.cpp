@@ -0,0 +1,158 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "../Arduino_GFX_Alloc.h"
+#include "Arduino_SaveUnder.h"
+
+Arduino_SaveUnder::Arduino_SaveUnder(int32_t pool_pixels, Arduino_Canvas *background)
+    : _pool(NULL), _pool_pixels(pool_pixels), _used(0), _depth(0), _overflow(0),
+      _bg_canvas(background), _window(NULL), _bg_draw(NULL), _bg_arg(NULL)
+{
+}
+
+Arduino_SaveUnder::Arduino_SaveUnder(
+    int32_t pool_pixels, Arduino_Canvas_Window *window, gfx_draw_callback_t background, void *arg)
+    : _pool(NULL), _pool_pixels(pool_pixels), _used(0), _depth(0), _overflow(0),
+      _bg_canvas(NULL), _window(window), _bg_draw(background), _bg_arg(arg)
+{
+}
+
+bool Arduino_SaveUnder::begin()
+{
+    _pool = (uint16_t *)gfx_alloc(_pool_pixels * 2, GFX_MEM_INTERNAL);
+    if (!_pool)
+    {
+        Serial.println(F("_pool allocation failed."));
+        return false;
+    }
+    return true;
+}
+
+bool Arduino_SaveUnder::save(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    if (!_pool)
+    {
+        return false;
+    }
+    if (_depth >= SAVE_UNDER_MAX_DEPTH)
+    {
+        Serial.println(F("Save-under too deep."));
+        _overflow++;
+        return false;
+    }
+
+    Arduino_GFX *bg = _bg_canvas ? (Arduino_GFX *)_bg_canvas : (Arduino_GFX *)_window;
+    int16_t x2 = x + w;
+    int16_t y2 = y + h;
+    if (x < 0)
+    {
+        x = 0;
+    }
+    if (y < 0)
+    {
+        y = 0;
+    }
+    if (x2 > bg->width())
+    {
+        x2 = bg->width();
+    }
+    if (y2 > bg->height())
+    {
+        y2 = bg->height();
+    }
+    w = x2 - x;
+    h = y2 - y;
+    if ((w <= 0) || (h <= 0))
+    {
+        // offscreen, keeps its place in the nesting all the same
+        w = h = 0;
+    }
+    else if ((_used + ((int32_t)w * h)) > _pool_pixels)
+    {
+        Serial.println(F("Save-under pool full."));
+        push(x, y, 0, 0);
+        return false;
+    }
+
+    uint16_t *buf = _pool + _used;
+    if (w)
+    {
+        if (_bg_canvas)
+        {
+            _bg_canvas->readRect(x, y, w, h, buf);
+        }
+        else
+        {
+            // regenerate the background in the window and keep its pixels
+            if (!_window->setWindow(x, y, w, h))
+            {
+                push(x, y, 0, 0);
+                return false;
+            }
+            _bg_draw(_window, _bg_arg);
+            if (_window->isBigEndian())
+            {
+                Arduino_DataBus::swapPixels(buf, _window->getFramebuffer(), (uint32_t)w * h);
+            }
+            else
+            {
+                memcpy(buf, _window->getFramebuffer(), (uint32_t)w * h * 2);
+            }
+        }
+    }
+
+    push(x, y, w, h);
+    return true;
+}
+
+// an empty level keeps a failed save paired with its restore()
+void Arduino_SaveUnder::push(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    gfx_rect_t *s = &_saves[_depth++];
+    s->x = x;
+    s->y = y;
+    s->w = w;
+    s->h = h;
+    _used += (int32_t)w * h;
+}
+
+bool Arduino_SaveUnder::restore(Arduino_G *target)
+{
+    if (_overflow)
+    {
+        _overflow--;
+        return false;
+    }
+    if (_depth == 0)
+    {
+        return false;
+    }
+    gfx_rect_t *s = &_saves[--_depth];
+    _used -= (int32_t)s->w * s->h;
+    if (s->w)
+    {
+        if (!target)
+        {
+            target = _bg_canvas ? (Arduino_G *)_bg_canvas : _window->getOutput();
+        }
+        int16_t x = s->x, y = s->y;
+        if (_window && (target == _window->getOutput()))
+        {
+            // window coordinates are screen ones, the window flushes them shifted
+            x += _window->getOutputX();
+            y += _window->getOutputY();
+        }
+        target->draw16bitRGBBitmap(x, y, _pool + _used, s->w, s->h);
+    }
+    return true;
+}
+
+void Arduino_SaveUnder::clear()
+{
+    _depth = 0;
+    _overflow = 0;
+    _used = 0;
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
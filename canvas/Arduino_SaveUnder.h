@@ -0,0 +1,57 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_SAVEUNDER_H_
+#define _ARDUINO_SAVEUNDER_H_
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas.h"
+#include "Arduino_Canvas_Window.h"
+
+#ifndef SAVE_UNDER_MAX_DEPTH
+#define SAVE_UNDER_MAX_DEPTH 4
+#endif
+
+// Keeps the background under moving objects in a pixel pool so it goes back
+// as one bitmap instead of being repainted. Saves nest, restore() puts back
+// the most recent one so stacked layers unwind in reverse order.
+class Arduino_SaveUnder
+{
+public:
+  Arduino_SaveUnder(int32_t pool_pixels, Arduino_Canvas *background);
+  // background has to paint every pixel of the window, which is not cleared first
+  Arduino_SaveUnder(int32_t pool_pixels, Arduino_Canvas_Window *window, gfx_draw_callback_t background, void *arg = NULL);
+
+  bool begin();
+  // false if the pool or the nesting depth is used up. Nothing is saved then,
+  // but the save keeps its place in the nesting and its restore() draws nothing.
+  bool save(int16_t x, int16_t y, int16_t w, int16_t h);
+  // NULL draws on the background canvas, or the window's output at the
+  // window's output offset
+  bool restore(Arduino_G *target = NULL);
+  void clear();
+
+  uint8_t getDepth() { return _depth; }
+  int32_t getUsedPixels() { return _used; }
+  int32_t getPoolPixels() { return _pool_pixels; }
+
+protected:
+  void push(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  uint16_t *_pool;
+  int32_t _pool_pixels;
+  int32_t _used;
+  gfx_rect_t _saves[SAVE_UNDER_MAX_DEPTH]; // pixels of each save follow those of the one before
+  uint8_t _depth;
+  uint8_t _overflow; // saves past SAVE_UNDER_MAX_DEPTH, restored as nothing
+  Arduino_Canvas *_bg_canvas;
+  Arduino_Canvas_Window *_window;
+  gfx_draw_callback_t _bg_draw;
+  void *_bg_arg;
+
+private:
+};
+
+#endif // _ARDUINO_SAVEUNDER_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,175 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "Arduino_SpriteLayer.h"
+
+Arduino_SpriteLayer::Arduino_SpriteLayer(
+    Arduino_Canvas_Window *window, gfx_draw_callback_t background, void *arg)
+    : _window(window), _bg_canvas(NULL), _bg_draw(background), _bg_arg(arg), _sprite_count(0)
+{
+}
+
+Arduino_SpriteLayer::Arduino_SpriteLayer(
+    Arduino_Canvas_Window *window, Arduino_Canvas *background)
+    : _window(window), _bg_canvas(background), _bg_draw(NULL), _bg_arg(NULL), _sprite_count(0)
+{
+}
+
+int8_t Arduino_SpriteLayer::addSprite(gfx_draw_callback_t draw, void *arg)
+{
+    if (_sprite_count >= SPRITE_LAYER_MAX_SPRITES)
+    {
+        Serial.println(F("Sprite layer full."));
+        return -1;
+    }
+    sprite_t *s = &_sprites[_sprite_count];
+    s->x = s->y = s->w = s->h = 0;
+    s->visible = false;
+    s->draw = draw;
+    s->arg = arg;
+    return _sprite_count++;
+}
+
+void Arduino_SpriteLayer::moveSprite(uint8_t id, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    if (id >= _sprite_count)
+    {
+        return;
+    }
+    sprite_t *s = &_sprites[id];
+    if (!s->visible)
+    {
+        s->x = x;
+        s->y = y;
+        s->w = w;
+        s->h = h;
+        s->visible = true;
+        composite(x, y, w, h);
+        return;
+    }
+
+    int16_t ox = s->x, oy = s->y, ow = s->w, oh = s->h;
+    s->x = x;
+    s->y = y;
+    s->w = w;
+    s->h = h;
+
+    int16_t ux = (ox < x) ? ox : x;
+    int16_t uy = (oy < y) ? oy : y;
+    int16_t ux2 = ((ox + ow) > (x + w)) ? (ox + ow) : (x + w);
+    int16_t uy2 = ((oy + oh) > (y + h)) ? (oy + oh) : (y + h);
+    // one pass over the union unless it is mostly empty space
+    if ((int32_t)(ux2 - ux) * (uy2 - uy) <= (int32_t)ow * oh + (int32_t)w * h)
+    {
+        composite(ux, uy, ux2 - ux, uy2 - uy);
+    }
+    else
+    {
+        composite(ox, oy, ow, oh);
+        composite(x, y, w, h);
+    }
+}
+
+void Arduino_SpriteLayer::hideSprite(uint8_t id)
+{
+    if ((id >= _sprite_count) || (!_sprites[id].visible))
+    {
+        return;
+    }
+    sprite_t *s = &_sprites[id];
+    s->visible = false;
+    composite(s->x, s->y, s->w, s->h);
+}
+
+void Arduino_SpriteLayer::redraw()
+{
+    composite(0, 0, _window->width(), _window->height());
+}
+
+void Arduino_SpriteLayer::redrawRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    composite(x, y, w, h);
+}
+
+void Arduino_SpriteLayer::composite(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    int16_t x2 = x + w;
+    int16_t y2 = y + h;
+    if (x < 0)
+    {
+        x = 0;
+    }
+    if (y < 0)
+    {
+        y = 0;
+    }
+    if (x2 > _window->width())
+    {
+        x2 = _window->width();
+    }
+    if (y2 > _window->height())
+    {
+        y2 = _window->height();
+    }
+    if ((x2 <= x) || (y2 <= y))
+    {
+        return;
+    }
+
+    // nothing to draw into when the window's begin() failed
+    int32_t capacity = _window->getBufferPixels();
+    if ((!_window->getFramebuffer()) || (capacity <= 0))
+    {
+        return;
+    }
+
+    // split into the widest bands the window buffer holds
+    int16_t bw = x2 - x;
+    if (bw > capacity)
+    {
+        bw = capacity;
+    }
+    // a buffer larger than the area would overflow the band height
+    int16_t bh = ((capacity / bw) < (y2 - y)) ? (capacity / bw) : (y2 - y);
+
+    for (int16_t by = y; by < y2; by += bh)
+    {
+        int16_t rows = ((y2 - by) < bh) ? (y2 - by) : bh;
+        for (int16_t bx = x; bx < x2; bx += bw)
+        {
+            int16_t cols = ((x2 - bx) < bw) ? (x2 - bx) : bw;
+            if (!_window->setWindow(bx, by, cols, rows))
+            {
+                continue; // background and sprites would draw through an empty window
+            }
+            if (_bg_canvas && _bg_canvas->isBigEndian())
+            {
+                _window->draw16bitBeRGBBitmap(0, by, _bg_canvas->getFramebuffer() + (int32_t)by * _bg_canvas->width(),
+                                              _bg_canvas->width(), rows);
+            }
+            else if (_bg_canvas)
+            {
+                _window->draw16bitRGBBitmap(0, by, _bg_canvas->getFramebuffer() + (int32_t)by * _bg_canvas->width(),
+                                            _bg_canvas->width(), rows);
+            }
+            else
+            {
+                _bg_draw(_window, _bg_arg);
+            }
+            for (uint8_t i = 0; i < _sprite_count; i++)
+            {
+                sprite_t *s = &_sprites[i];
+                if (s->visible &&
+                    (s->x < bx + cols) && (s->x + s->w > bx) &&
+                    (s->y < by + rows) && (s->y + s->h > by))
+                {
+                    s->draw(_window, s->arg);
+                }
+            }
+            _window->flush();
+        }
+    }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
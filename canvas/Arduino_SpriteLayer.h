@@ -0,0 +1,52 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_SPRITELAYER_H_
+#define _ARDUINO_SPRITELAYER_H_
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas.h"
+#include "Arduino_Canvas_Window.h"
+
+#ifndef SPRITE_LAYER_MAX_SPRITES
+#define SPRITE_LAYER_MAX_SPRITES 4
+#endif
+
+// Composites moving sprites over a static background through a window canvas,
+// only the bounding boxes a sprite leaves and enters are redrawn
+class Arduino_SpriteLayer
+{
+public:
+  Arduino_SpriteLayer(Arduino_Canvas_Window *window, gfx_draw_callback_t background, void *arg = NULL);
+  Arduino_SpriteLayer(Arduino_Canvas_Window *window, Arduino_Canvas *background); // background framebuffer is read as is, keep it at rotation 0
+
+  int8_t addSprite(gfx_draw_callback_t draw, void *arg = NULL);
+  void moveSprite(uint8_t id, int16_t x, int16_t y, int16_t w, int16_t h);
+  void hideSprite(uint8_t id);
+  void redraw();
+  void redrawRect(int16_t x, int16_t y, int16_t w, int16_t h);
+
+protected:
+  void composite(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  typedef struct
+  {
+    int16_t x, y, w, h;
+    bool visible;
+    gfx_draw_callback_t draw;
+    void *arg;
+  } sprite_t;
+
+  Arduino_Canvas_Window *_window;
+  Arduino_Canvas *_bg_canvas;
+  gfx_draw_callback_t _bg_draw;
+  void *_bg_arg;
+  sprite_t _sprites[SPRITE_LAYER_MAX_SPRITES];
+  uint8_t _sprite_count;
+
+private:
+};
+
+#endif // _ARDUINO_SPRITELAYER_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -118,6 +118,14 @@
 #define GC9A01_IPS true
 //  Number of pixels to inset the representation of the turntable pit.
 #define PIT_OFFSET 30
+//  Width of the turntable bridge in pixels, 1 draws a single anti-aliased line.
+#define TURNTABLE_WIDTH 5
+//  Uncomment to drive the display through the DMA SPI bus on ESP32 and STM32 (SPI1 only).
+// #define GC9A01_DMA
+//  Uncomment to merge the many small window updates of text and outlines (not on AVR).
+// #define GC9A01_BATCH
+//  Uncomment to time a few SPI clocks at first start-up and keep the fastest in EEPROM (not on AVR).
+// #define GC9A01_AUTO_SPEED
 /////////////////////////////////////////////////////////////////////////////////////
 //  END: TURNTABLE mode configuration options.
 /////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,354 @@
+/*
+ * Coalesces the small address-window updates of lines, circles and text
+ * into fewer, larger windows before they reach the real bus
+ */
+#include "Arduino_BatchBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+Arduino_BatchBus::Arduino_BatchBus(Arduino_DataBus *bus, uint8_t caset, uint8_t raset, uint8_t ramwr)
+    : _bus(bus), _caset(caset), _raset(raset), _ramwr(ramwr),
+      _vx_known(false), _vy_known(false), _panel_known(false),
+      _ramwr_pending(false), _has_bg(false), _bg(0), _seg_count(0)
+{
+}
+
+void Arduino_BatchBus::begin(int32_t speed, int8_t dataMode)
+{
+  _bus->begin(speed, dataMode);
+}
+
+void Arduino_BatchBus::beginWrite()
+{
+  _bus->beginWrite();
+}
+
+void Arduino_BatchBus::endWrite()
+{
+  flush();
+  _bus->endWrite();
+}
+
+void Arduino_BatchBus::writeCommand(uint8_t c)
+{
+  if (c == _ramwr)
+  {
+    // held back, the data that follows may join the pending window
+    _ramwr_pending = true;
+    return;
+  }
+
+  otherCommand();
+  if ((c == _caset) || (c == _raset))
+  {
+    // window parameters sent byte by byte, stop tracking it
+    _vx_known = _vy_known = _panel_known = false;
+  }
+  _bus->writeCommand(c);
+}
+
+void Arduino_BatchBus::writeCommand16(uint16_t c)
+{
+  otherCommand();
+  _bus->writeCommand16(c);
+}
+
+void Arduino_BatchBus::write(uint8_t d)
+{
+  beginData();
+  _bus->write(d);
+}
+
+void Arduino_BatchBus::write16(uint16_t d)
+{
+  if (_ramwr_pending && _vx_known && _vy_known && (_vx0 == _vx1) && (_vy0 == _vy1))
+  {
+    _ramwr_pending = false;
+    queueSpan(_vx0, _vy0, 1, 1, d);
+    return;
+  }
+
+  beginData();
+  _bus->write16(d);
+}
+
+void Arduino_BatchBus::writeC8D8(uint8_t c, uint8_t d)
+{
+  otherCommand();
+  _bus->writeC8D8(c, d);
+}
+
+void Arduino_BatchBus::writeC16D16(uint16_t c, uint16_t d)
+{
+  otherCommand();
+  _bus->writeC16D16(c, d);
+}
+
+void Arduino_BatchBus::writeC8D16(uint8_t c, uint16_t d)
+{
+  otherCommand();
+  _bus->writeC8D16(c, d);
+}
+
+void Arduino_BatchBus::writeC8D16D16(uint8_t c, uint16_t d1, uint16_t d2)
+{
+  if (c == _caset)
+  {
+    // only recorded, the panel gets it with the data that needs it
+    _vx0 = d1;
+    _vx1 = d2;
+    _vx_known = true;
+    _ramwr_pending = false;
+  }
+  else if (c == _raset)
+  {
+    _vy0 = d1;
+    _vy1 = d2;
+    _vy_known = true;
+    _ramwr_pending = false;
+  }
+  else
+  {
+    otherCommand();
+    _bus->writeC8D16D16(c, d1, d2);
+  }
+}
+
+void Arduino_BatchBus::writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2)
+{
+  if ((c == _caset) || (c == _raset))
+  {
+    writeC8D16D16(c, d1, d2);
+  }
+  else
+  {
+    otherCommand();
+    _bus->writeC8D16D16Split(c, d1, d2);
+  }
+}
+
+void Arduino_BatchBus::writeRepeat(uint16_t p, uint32_t len)
+{
+  if (_ramwr_pending && _vx_known && _vy_known && (_vx1 >= _vx0) && (_vy1 >= _vy0))
+  {
+    uint16_t w = _vx1 - _vx0 + 1;
+    uint16_t h = _vy1 - _vy0 + 1;
+    if (len == (uint32_t)w * h)
+    {
+      _ramwr_pending = false;
+      queueSpan(_vx0, _vy0, w, h, p);
+      return;
+    }
+  }
+
+  beginData();
+  _bus->writeRepeat(p, len);
+}
+
+void Arduino_BatchBus::writePixels(uint16_t *data, uint32_t len)
+{
+  beginData();
+  _bus->writePixels(data, len);
+}
+
+void Arduino_BatchBus::writeBytes(uint8_t *data, uint32_t len)
+{
+  beginData();
+  _bus->writeBytes(data, len);
+}
+
+void Arduino_BatchBus::writePattern(uint8_t *data, uint8_t len, uint32_t repeat)
+{
+  beginData();
+  _bus->writePattern(data, len, repeat);
+}
+
+void Arduino_BatchBus::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  beginData();
+  _bus->writeIndexedPixels(data, idx, len);
+}
+
+void Arduino_BatchBus::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  beginData();
+  _bus->writeIndexedPixelsDouble(data, idx, len);
+}
+
+bool Arduino_BatchBus::supportsZeroCopy(const void *data, bool big_endian)
+{
+  return _bus->supportsZeroCopy(data, big_endian);
+}
+
+bool Arduino_BatchBus::supportsAsync()
+{
+  return _bus->supportsAsync();
+}
+
+void Arduino_BatchBus::writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t done, void *arg)
+{
+  beginData();
+  _bus->writePixelsAsync(data, len, done, arg);
+}
+
+bool Arduino_BatchBus::isBusy()
+{
+  return _bus->isBusy();
+}
+
+void Arduino_BatchBus::waitAsync()
+{
+  _bus->waitAsync();
+}
+
+void Arduino_BatchBus::setBackground(uint16_t bg)
+{
+  _bg = bg;
+  _has_bg = true;
+}
+
+void Arduino_BatchBus::clearBackground()
+{
+  _has_bg = false;
+}
+
+void Arduino_BatchBus::flush()
+{
+  if (!_seg_count)
+  {
+    return;
+  }
+
+  setPanelWindow(_run_x, _run_x + _run_w - 1, _run_y, _run_y + _run_h - 1);
+  _bus->writeCommand(_ramwr);
+  for (uint8_t i = 0; i < _seg_count; i++)
+  {
+    if (_seg_len[i] == 1)
+    {
+      _bus->write16(_seg_color[i]);
+    }
+    else
+    {
+      _bus->writeRepeat(_seg_color[i], _seg_len[i]);
+    }
+  }
+  _seg_count = 0;
+}
+
+// join a filled w x h window to the pending one, or send that and start over
+void Arduino_BatchBus::queueSpan(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+  if (_seg_count)
+  {
+    uint16_t gap;
+    if ((_run_h == 1) && (h == 1) && (y == _run_y) && (x >= (_run_x + _run_w)))
+    {
+      // further along the same row
+      gap = x - (_run_x + _run_w);
+      if (((gap == 0) || (_has_bg && (gap <= BATCHBUS_MAX_GAP))) && (_seg_count <= (BATCHBUS_MAX_SEGMENTS - 2)))
+      {
+        if (gap)
+        {
+          addSegment(_bg, gap);
+        }
+        addSegment(color, w);
+        _run_w += gap + w;
+        return;
+      }
+    }
+    else if ((_run_w == 1) && (w == 1) && (x == _run_x) && (y >= (_run_y + _run_h)))
+    {
+      // further down the same column
+      gap = y - (_run_y + _run_h);
+      if (((gap == 0) || (_has_bg && (gap <= BATCHBUS_MAX_GAP))) && (_seg_count <= (BATCHBUS_MAX_SEGMENTS - 2)))
+      {
+        if (gap)
+        {
+          addSegment(_bg, gap);
+        }
+        addSegment(color, h);
+        _run_h += gap + h;
+        return;
+      }
+    }
+    else if ((_seg_count == 1) && (color == _seg_color[0]))
+    {
+      // same color stacked below or beside a single colored window
+      if ((x == _run_x) && (w == _run_w) && (y == (_run_y + _run_h)))
+      {
+        _run_h += h;
+        _seg_len[0] += (uint32_t)w * h;
+        return;
+      }
+      if ((y == _run_y) && (h == _run_h) && (x == (_run_x + _run_w)))
+      {
+        _run_w += w;
+        _seg_len[0] += (uint32_t)w * h;
+        return;
+      }
+    }
+    flush();
+  }
+
+  _run_x = x;
+  _run_y = y;
+  _run_w = w;
+  _run_h = h;
+  addSegment(color, (uint32_t)w * h);
+}
+
+void Arduino_BatchBus::addSegment(uint16_t color, uint32_t len)
+{
+  if (_seg_count && (_seg_color[_seg_count - 1] == color))
+  {
+    _seg_len[_seg_count - 1] += len;
+  }
+  else
+  {
+    _seg_color[_seg_count] = color;
+    _seg_len[_seg_count] = len;
+    _seg_count++;
+  }
+}
+
+// data that cannot be queued goes out in order, into the window the driver asked for
+void Arduino_BatchBus::beginData()
+{
+  flush();
+  if (_ramwr_pending)
+  {
+    if (_vx_known && _vy_known)
+    {
+      setPanelWindow(_vx0, _vx1, _vy0, _vy1);
+    }
+    _bus->writeCommand(_ramwr);
+    _ramwr_pending = false;
+  }
+}
+
+void Arduino_BatchBus::otherCommand()
+{
+  flush();
+  // a memory write with no data has no effect, it can be dropped
+  _ramwr_pending = false;
+}
+
+// only the axes that differ from what the panel already has are sent
+void Arduino_BatchBus::setPanelWindow(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1)
+{
+  if ((!_panel_known) || (x0 != _px0) || (x1 != _px1))
+  {
+    _bus->writeC8D16D16(_caset, x0, x1);
+    _px0 = x0;
+    _px1 = x1;
+  }
+  if ((!_panel_known) || (y0 != _py0) || (y1 != _py1))
+  {
+    _bus->writeC8D16D16(_raset, y0, y1);
+    _py0 = y0;
+    _py1 = y1;
+  }
+  _panel_known = true;
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,84 @@
+/*
+ * Coalesces the small address-window updates of lines, circles and text
+ * into fewer, larger windows before they reach the real bus
+ */
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_BATCHBUS_H_
+#define _ARDUINO_BATCHBUS_H_
+
+#ifndef BATCHBUS_MAX_SEGMENTS
+#define BATCHBUS_MAX_SEGMENTS 32 // color runs held for the pending window
+#endif
+#ifndef BATCHBUS_MAX_GAP
+#define BATCHBUS_MAX_GAP 5 // widest background gap filled instead of opening a new window
+#endif
+
+class Arduino_BatchBus : public Arduino_DataBus
+{
+public:
+  // caset, raset and ramwr are the panel's column, row and memory write commands
+  Arduino_BatchBus(Arduino_DataBus *bus, uint8_t caset = 0x2A, uint8_t raset = 0x2B, uint8_t ramwr = 0x2C); // Constructor
+
+  void begin(int32_t speed = GFX_NOT_DEFINED, int8_t dataMode = GFX_NOT_DEFINED) override;
+  void beginWrite() override;
+  void endWrite() override;
+  void writeCommand(uint8_t) override;
+  void writeCommand16(uint16_t) override;
+  void write(uint8_t) override;
+  void write16(uint16_t) override;
+  void writeC8D8(uint8_t c, uint8_t d) override;
+  void writeC16D16(uint16_t c, uint16_t d) override;
+  void writeC8D16(uint8_t c, uint16_t d) override;
+  void writeC8D16D16(uint8_t c, uint16_t d1, uint16_t d2) override;
+  void writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2) override;
+  void writeRepeat(uint16_t p, uint32_t len) override;
+  void writePixels(uint16_t *data, uint32_t len) override;
+  void writeBytes(uint8_t *data, uint32_t len) override;
+  void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) override;
+  void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
+  void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
+  bool supportsZeroCopy(const void *data, bool big_endian) override;
+  bool supportsAsync() override;
+  void writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t done = NULL, void *arg = NULL) override;
+  bool isBusy() override;
+  void waitAsync() override;
+
+  // Only when everything between the spans drawn is known to be bg, e.g. on a cleared screen
+  void setBackground(uint16_t bg);
+  void clearBackground();
+  // Send the pending window, endWrite() does this too
+  void flush();
+
+protected:
+  void queueSpan(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+  void addSegment(uint16_t color, uint32_t len);
+  void beginData();
+  void otherCommand();
+  void setPanelWindow(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1);
+
+private:
+  Arduino_DataBus *_bus;
+  uint8_t _caset, _raset, _ramwr;
+
+  // window the display driver last set, and the one the panel really has
+  uint16_t _vx0, _vx1, _vy0, _vy1;
+  uint16_t _px0, _px1, _py0, _py1;
+  bool _vx_known, _vy_known, _panel_known;
+  bool _ramwr_pending;
+
+  bool _has_bg;
+  uint16_t _bg;
+
+  // pending window, filled in row-major order by the segments
+  uint16_t _run_x, _run_y, _run_w, _run_h;
+  uint16_t _seg_color[BATCHBUS_MAX_SEGMENTS];
+  uint32_t _seg_len[BATCHBUS_MAX_SEGMENTS];
+  uint8_t _seg_count;
+};
+
+#endif // _ARDUINO_BATCHBUS_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
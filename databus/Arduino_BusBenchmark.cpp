@@ -0,0 +1,272 @@
+/*
+ * Measures the throughput of a data bus and picks the fastest of several
+ * buses, or bus speeds, for the attached panel
+ */
+#include "Arduino_BusBenchmark.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+// cores whose EEPROM is a RAM copy of flash, written back by commit()
+#if !defined(BUSBENCHMARK_EEPROM_COMMIT) && (defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040))
+#define BUSBENCHMARK_EEPROM_COMMIT
+#endif
+
+#define BUSBENCHMARK_MAGIC 0xB5
+
+enum
+{
+  BUSBENCHMARK_REPEAT,
+  BUSBENCHMARK_PIXELS,
+  BUSBENCHMARK_BYTES,
+  BUSBENCHMARK_COMMANDS
+};
+
+typedef struct
+{
+  uint8_t magic;
+  uint8_t count; // candidates when saved
+  uint8_t index;
+  int32_t speed;
+} busbenchmark_record_t;
+
+Arduino_BusBenchmark::Arduino_BusBenchmark(uint16_t w, uint16_t h, uint8_t caset, uint8_t raset, uint8_t ramwr)
+    : _w(w), _h(h), _caset(caset), _raset(raset), _ramwr(ramwr), _count(0), _selected(GFX_NOT_DEFINED)
+{
+}
+
+// one full screen of data through a single write method, returns the time taken in us
+uint32_t Arduino_BusBenchmark::measure(Arduino_DataBus *bus, uint8_t workload, uint32_t *bytes)
+{
+  uint16_t buf[BUSBENCHMARK_BUFFER_PIXELS];
+  uint32_t len = (uint32_t)_w * _h;
+  uint32_t xferLen;
+  uint32_t start;
+
+  for (uint16_t i = 0; i < BUSBENCHMARK_BUFFER_PIXELS; i++)
+  {
+    buf[i] = i * 0x0841; // grey ramp
+  }
+
+  start = micros();
+  bus->beginWrite();
+  if (workload == BUSBENCHMARK_COMMANDS)
+  {
+    // four short windows on every row, the way lines and text reach the panel
+    uint16_t step = _w / 4;
+    *bytes = 0;
+    for (uint16_t y = 0; y < _h; y++)
+    {
+      for (uint16_t x = 0; (x + BUSBENCHMARK_WINDOW_PIXELS) <= _w; x += step)
+      {
+        bus->writeC8D16D16(_caset, x, x + BUSBENCHMARK_WINDOW_PIXELS - 1);
+        bus->writeC8D16D16(_raset, y, y);
+        bus->writeCommand(_ramwr);
+        bus->writeRepeat(buf[y & 0xFF], BUSBENCHMARK_WINDOW_PIXELS);
+        *bytes += 11 + (BUSBENCHMARK_WINDOW_PIXELS * 2);
+      }
+    }
+  }
+  else
+  {
+    bus->writeC8D16D16(_caset, 0, _w - 1);
+    bus->writeC8D16D16(_raset, 0, _h - 1);
+    bus->writeCommand(_ramwr);
+    *bytes = 11 + (len * 2);
+    if (workload == BUSBENCHMARK_REPEAT)
+    {
+      bus->writeRepeat(0xF81F, len);
+    }
+    else
+    {
+      while (len)
+      {
+        xferLen = (len < BUSBENCHMARK_BUFFER_PIXELS) ? len : BUSBENCHMARK_BUFFER_PIXELS;
+        if (workload == BUSBENCHMARK_PIXELS)
+        {
+          bus->writePixels(buf, xferLen);
+        }
+        else
+        {
+          bus->writeBytes((uint8_t *)buf, xferLen * 2);
+        }
+        len -= xferLen;
+      }
+    }
+  }
+  bus->endWrite();
+  bus->waitAsync();
+  return micros() - start;
+}
+
+void Arduino_BusBenchmark::run(Arduino_DataBus *bus, gfx_bus_benchmark_t *result)
+{
+  uint32_t *rate[4] = {&result->repeat, &result->pixels, &result->bytes, &result->commands};
+  uint32_t bytes, us;
+  uint64_t us_per_gb = 0;
+
+  for (uint8_t i = BUSBENCHMARK_REPEAT; i <= BUSBENCHMARK_COMMANDS; i++)
+  {
+    us = measure(bus, i, &bytes);
+    if (!us)
+    {
+      us = 1;
+    }
+    *rate[i] = (uint64_t)bytes * 1000 / us; // bytes per us is MB/s
+    us_per_gb += (uint64_t)us * 1000000000 / bytes;
+  }
+  // harmonic mean, as if the same amount went through each workload
+  result->total = 4000000000000ULL / us_per_gb;
+}
+
+void Arduino_BusBenchmark::print(const char *name, const gfx_bus_benchmark_t *result, Print *out)
+{
+  out->print(name);
+  out->print(F(": repeat "));
+  out->print(result->repeat / 1000.0, 2);
+  out->print(F(", pixels "));
+  out->print(result->pixels / 1000.0, 2);
+  out->print(F(", bytes "));
+  out->print(result->bytes / 1000.0, 2);
+  out->print(F(", commands "));
+  out->print(result->commands / 1000.0, 2);
+  out->print(F(", total "));
+  out->print(result->total / 1000.0, 2);
+  out->println(F(" MB/s"));
+}
+
+int8_t Arduino_BusBenchmark::addCandidate(const char *name, Arduino_DataBus *bus, int32_t speed)
+{
+  if (_count >= BUSBENCHMARK_MAX_CANDIDATES)
+  {
+    Serial.println(F("Bus benchmark: too many candidates"));
+    return GFX_NOT_DEFINED;
+  }
+
+  _name[_count] = name;
+  _bus[_count] = bus;
+  _speed[_count] = speed;
+  return _count++;
+}
+
+int8_t Arduino_BusBenchmark::select(gfx_bus_verify_cb_t verify, void *arg, Print *out)
+{
+  gfx_bus_benchmark_t result;
+  uint32_t best = 0;
+
+  _selected = GFX_NOT_DEFINED;
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    _bus[i]->begin(_speed[i]);
+    if (verify && !verify(_bus[i], _speed[i], arg))
+    {
+      if (out)
+      {
+        out->print(_name[i]);
+        out->println(F(": rejected"));
+      }
+      continue;
+    }
+
+    run(_bus[i], &result);
+    if (out)
+    {
+      print(_name[i], &result, out);
+    }
+    if (result.total > best)
+    {
+      best = result.total;
+      _selected = i;
+    }
+  }
+  // leave the winner running as selected, not the last candidate tried
+  if (_selected != GFX_NOT_DEFINED)
+  {
+    _bus[_selected]->begin(_speed[_selected]);
+  }
+  return _selected;
+}
+
+#if defined(BUSBENCHMARK_EEPROM)
+#if defined(BUSBENCHMARK_EEPROM_COMMIT)
+// The sketch may already have EEPROM begun for its own settings, end() would
+// free that copy under it. An open copy is used as it is and left open, only
+// a copy begun here is ended here. Returns false when the copy is too small.
+static bool busbenchmark_eeprom_begin(size_t size, bool *begun)
+{
+  *begun = (EEPROM.length() == 0);
+  if (*begun)
+  {
+    EEPROM.begin(size);
+  }
+  if (EEPROM.length() < size)
+  {
+    Serial.println(F("Bus benchmark: EEPROM smaller than the saved choice"));
+    if (*begun)
+    {
+      EEPROM.end();
+    }
+    return false;
+  }
+  return true;
+}
+#endif // defined(BUSBENCHMARK_EEPROM_COMMIT)
+
+bool Arduino_BusBenchmark::load(int address)
+{
+  busbenchmark_record_t record;
+
+#if defined(BUSBENCHMARK_EEPROM_COMMIT)
+  bool begun;
+  if (!busbenchmark_eeprom_begin(address + sizeof(record), &begun))
+  {
+    return false;
+  }
+#endif
+  EEPROM.get(address, record);
+#if defined(BUSBENCHMARK_EEPROM_COMMIT)
+  if (begun)
+  {
+    EEPROM.end();
+  }
+#endif
+
+  if ((record.magic != BUSBENCHMARK_MAGIC) || (record.count != _count) || (record.index >= _count) || (record.speed != _speed[record.index]))
+  {
+    return false;
+  }
+  _selected = record.index;
+  return true;
+}
+
+void Arduino_BusBenchmark::save(int address)
+{
+  busbenchmark_record_t record;
+
+  if (_selected == GFX_NOT_DEFINED)
+  {
+    return;
+  }
+  record.magic = BUSBENCHMARK_MAGIC;
+  record.count = _count;
+  record.index = _selected;
+  record.speed = _speed[_selected];
+
+#if defined(BUSBENCHMARK_EEPROM_COMMIT)
+  bool begun;
+  if (!busbenchmark_eeprom_begin(address + sizeof(record), &begun))
+  {
+    return;
+  }
+#endif
+  EEPROM.put(address, record);
+#if defined(BUSBENCHMARK_EEPROM_COMMIT)
+  EEPROM.commit();
+  if (begun)
+  {
+    EEPROM.end();
+  }
+#endif
+}
+#endif // defined(BUSBENCHMARK_EEPROM)
+
+#endif // !defined(LITTLE_FOOT_PRINT)
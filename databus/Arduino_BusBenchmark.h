@@ -0,0 +1,82 @@
+/*
+ * Measures the throughput of a data bus and picks the fastest of several
+ * buses, or bus speeds, for the attached panel
+ */
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_BUSBENCHMARK_H_
+#define _ARDUINO_BUSBENCHMARK_H_
+
+#if __has_include(<EEPROM.h>)
+#include <EEPROM.h>
+#define BUSBENCHMARK_EEPROM // load() and save() keep the choice in EEPROM
+#endif
+
+#ifndef BUSBENCHMARK_MAX_CANDIDATES
+#define BUSBENCHMARK_MAX_CANDIDATES 8
+#endif
+#define BUSBENCHMARK_BUFFER_PIXELS 256 // source buffer of writePixels() and writeBytes()
+#define BUSBENCHMARK_WINDOW_PIXELS 8   // pixels in each window of the command workload
+
+// Throughput of each workload in kB/s, total weighs the four workloads equally
+typedef struct
+{
+  uint32_t repeat;   // writeRepeat() fill
+  uint32_t pixels;   // writePixels() from RAM
+  uint32_t bytes;    // writeBytes() from RAM
+  uint32_t commands; // small windows: column, row and memory write commands with a few pixels each
+  uint32_t total;
+} gfx_bus_benchmark_t;
+
+// Returns false when the panel does not work with the bus as begun, the candidate is then skipped
+typedef bool (*gfx_bus_verify_cb_t)(Arduino_DataBus *bus, int32_t speed, void *arg);
+
+class Arduino_BusBenchmark
+{
+public:
+  // w x h is the panel's memory, caset, raset and ramwr its column, row and memory write commands
+  Arduino_BusBenchmark(uint16_t w = 240, uint16_t h = 240, uint8_t caset = 0x2A, uint8_t raset = 0x2B, uint8_t ramwr = 0x2C); // Constructor
+
+  // The bus has to be begun, it is left holding garbage in the panel's memory
+  void run(Arduino_DataBus *bus, gfx_bus_benchmark_t *result);
+  void print(const char *name, const gfx_bus_benchmark_t *result, Print *out = &Serial);
+
+  // The same bus may be added more than once with different speeds, e.g.
+  // the SPI clock or the write strobe frequency of the ESP32-S3 LCD buses
+  int8_t addCandidate(const char *name, Arduino_DataBus *bus, int32_t speed = GFX_NOT_DEFINED);
+  // Begins and measures every candidate that verify accepts, returns the
+  // fastest or GFX_NOT_DEFINED. The fastest is begun again before returning,
+  // on a tie the candidate added first wins.
+  int8_t select(gfx_bus_verify_cb_t verify = NULL, void *arg = NULL, Print *out = NULL);
+
+#if defined(BUSBENCHMARK_EEPROM)
+  // The candidates must be added in the same order as when the choice was saved.
+  // EEPROM the sketch has already begun is used and left open.
+  bool load(int address);
+  void save(int address);
+#endif // defined(BUSBENCHMARK_EEPROM)
+
+  int8_t selected() { return _selected; }
+  Arduino_DataBus *selectedBus() { return (_selected == GFX_NOT_DEFINED) ? NULL : _bus[_selected]; }
+  int32_t selectedSpeed() { return (_selected == GFX_NOT_DEFINED) ? GFX_NOT_DEFINED : _speed[_selected]; }
+  const char *selectedName() { return (_selected == GFX_NOT_DEFINED) ? NULL : _name[_selected]; }
+
+protected:
+  uint32_t measure(Arduino_DataBus *bus, uint8_t workload, uint32_t *bytes);
+
+private:
+  uint16_t _w, _h;
+  uint8_t _caset, _raset, _ramwr;
+
+  const char *_name[BUSBENCHMARK_MAX_CANDIDATES];
+  Arduino_DataBus *_bus[BUSBENCHMARK_MAX_CANDIDATES];
+  int32_t _speed[BUSBENCHMARK_MAX_CANDIDATES];
+  uint8_t _count;
+  int8_t _selected;
+};
+
+#endif // _ARDUINO_BUSBENCHMARK_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
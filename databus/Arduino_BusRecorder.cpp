@@ -0,0 +1,192 @@
+/*
+ * Pass-through bus that counts command, parameter and pixel traffic, with
+ * no output bus it just measures a drawing sequence
+ */
+#include "Arduino_BusRecorder.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+Arduino_BusRecorder::Arduino_BusRecorder(Arduino_DataBus *bus, uint8_t ramwr)
+    : _bus(bus), _ramwr(ramwr), _in_ram(false)
+{
+  reset();
+}
+
+void Arduino_BusRecorder::reset()
+{
+  _command_bytes = 0;
+  _pixel_bytes = 0;
+  _windows = 0;
+  _transactions = 0;
+}
+
+void Arduino_BusRecorder::countData(uint32_t bytes)
+{
+  if (_in_ram)
+  {
+    _pixel_bytes += bytes;
+  }
+  else
+  {
+    _command_bytes += bytes;
+  }
+}
+
+void Arduino_BusRecorder::begin(int32_t speed, int8_t dataMode)
+{
+  if (_bus)
+  {
+    _bus->begin(speed, dataMode);
+  }
+}
+
+void Arduino_BusRecorder::beginWrite()
+{
+  _transactions++;
+  if (_bus)
+  {
+    _bus->beginWrite();
+  }
+}
+
+void Arduino_BusRecorder::endWrite()
+{
+  if (_bus)
+  {
+    _bus->endWrite();
+  }
+}
+
+void Arduino_BusRecorder::writeCommand(uint8_t c)
+{
+  _command_bytes++;
+  _in_ram = (c == _ramwr);
+  if (_in_ram)
+  {
+    _windows++;
+  }
+  if (_bus)
+  {
+    _bus->writeCommand(c);
+  }
+}
+
+void Arduino_BusRecorder::writeCommand16(uint16_t c)
+{
+  _command_bytes += 2;
+  _in_ram = false;
+  if (_bus)
+  {
+    _bus->writeCommand16(c);
+  }
+}
+
+void Arduino_BusRecorder::write(uint8_t d)
+{
+  countData(1);
+  if (_bus)
+  {
+    _bus->write(d);
+  }
+}
+
+void Arduino_BusRecorder::write16(uint16_t d)
+{
+  countData(2);
+  if (_bus)
+  {
+    _bus->write16(d);
+  }
+}
+
+void Arduino_BusRecorder::writeRepeat(uint16_t p, uint32_t len)
+{
+  countData(len * 2);
+  if (_bus)
+  {
+    _bus->writeRepeat(p, len);
+  }
+}
+
+void Arduino_BusRecorder::writePixels(uint16_t *data, uint32_t len)
+{
+  countData(len * 2);
+  if (_bus)
+  {
+    _bus->writePixels(data, len);
+  }
+}
+
+void Arduino_BusRecorder::writeBytes(uint8_t *data, uint32_t len)
+{
+  countData(len);
+  if (_bus)
+  {
+    _bus->writeBytes(data, len);
+  }
+}
+
+void Arduino_BusRecorder::writePattern(uint8_t *data, uint8_t len, uint32_t repeat)
+{
+  countData((uint32_t)len * repeat);
+  if (_bus)
+  {
+    _bus->writePattern(data, len, repeat);
+  }
+}
+
+void Arduino_BusRecorder::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  countData(len * 2);
+  if (_bus)
+  {
+    _bus->writeIndexedPixels(data, idx, len);
+  }
+}
+
+void Arduino_BusRecorder::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  countData(len * 4);
+  if (_bus)
+  {
+    _bus->writeIndexedPixelsDouble(data, idx, len);
+  }
+}
+
+bool Arduino_BusRecorder::supportsZeroCopy(const void *data, bool big_endian)
+{
+  return _bus ? _bus->supportsZeroCopy(data, big_endian) : false;
+}
+
+bool Arduino_BusRecorder::supportsAsync()
+{
+  return _bus ? _bus->supportsAsync() : false;
+}
+
+void Arduino_BusRecorder::writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t done, void *arg)
+{
+  countData(len * 2);
+  if (_bus)
+  {
+    _bus->writePixelsAsync(data, len, done, arg);
+  }
+  else if (done)
+  {
+    done(arg);
+  }
+}
+
+bool Arduino_BusRecorder::isBusy()
+{
+  return _bus ? _bus->isBusy() : false;
+}
+
+void Arduino_BusRecorder::waitAsync()
+{
+  if (_bus)
+  {
+    _bus->waitAsync();
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,55 @@
+/*
+ * Pass-through bus that counts command, parameter and pixel traffic, with
+ * no output bus it just measures a drawing sequence
+ */
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_BUSRECORDER_H_
+#define _ARDUINO_BUSRECORDER_H_
+
+class Arduino_BusRecorder : public Arduino_DataBus
+{
+public:
+  // ramwr is the panel's memory write command, data after it counts as pixels
+  Arduino_BusRecorder(Arduino_DataBus *bus = NULL, uint8_t ramwr = 0x2C); // Constructor
+
+  void begin(int32_t speed = GFX_NOT_DEFINED, int8_t dataMode = GFX_NOT_DEFINED) override;
+  void beginWrite() override;
+  void endWrite() override;
+  void writeCommand(uint8_t) override;
+  void writeCommand16(uint16_t) override;
+  void write(uint8_t) override;
+  void write16(uint16_t) override;
+  void writeRepeat(uint16_t p, uint32_t len) override;
+  void writePixels(uint16_t *data, uint32_t len) override;
+  void writeBytes(uint8_t *data, uint32_t len) override;
+  void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) override;
+  void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
+  void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
+  bool supportsZeroCopy(const void *data, bool big_endian) override;
+  bool supportsAsync() override;
+  void writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t done = NULL, void *arg = NULL) override;
+  bool isBusy() override;
+  void waitAsync() override;
+
+  void reset();
+  uint32_t getCommandBytes() { return _command_bytes; } // commands and their parameters
+  uint32_t getPixelBytes() { return _pixel_bytes; }
+  uint32_t getWindows() { return _windows; }           // memory writes started
+  uint32_t getTransactions() { return _transactions; } // beginWrite() calls
+
+protected:
+  void countData(uint32_t bytes);
+
+private:
+  Arduino_DataBus *_bus;
+  uint8_t _ramwr;
+  bool _in_ram;
+  uint32_t _command_bytes, _pixel_bytes, _windows, _transactions;
+};
+
+#endif // _ARDUINO_BUSRECORDER_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,683 @@
+/*
+ * DMA driven SPI bus for ESP32 (ESP-IDF spi_master) and STM32F1/F4 (SPI TX DMA)
+ */
+#include "Arduino_DMASPI.h"
+#include "Arduino_GFX_Alloc.h"
+
+#if defined(ESP32) || (defined(ARDUINO_ARCH_STM32) && (defined(STM32F1xx) || defined(STM32F4xx)))
+
+#if !defined(ESP32)
+#include "PeripheralPins.h"
+#include "pinmap.h"
+
+#if defined(STM32F1xx)
+#define DMASPI_TC_FLAG (DMA_ISR_TCIF1 << _dmaShift)
+#define DMASPI_ALL_FLAGS (DMA_IFCR_CGIF1 << _dmaShift)
+#else
+#define DMASPI_TC_FLAG (DMA_LISR_TCIF0 << _dmaShift)
+#define DMASPI_ALL_FLAGS ((DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0) << _dmaShift)
+#endif
+#endif
+
+#if defined(ESP32)
+Arduino_DMASPI::Arduino_DMASPI(int8_t dc, int8_t cs, int8_t sck, int8_t mosi, spi_host_device_t host)
+    : _dc(dc), _cs(cs), _sck(sck), _mosi(mosi), _host(host), _handle(NULL), _inflight(0), _next_trans(0),
+      _dma_busy(false), _cs_release_pending(false), _done_cb(NULL), _done_arg(NULL), _fill_buf(0)
+{
+  _buf[0] = _buf[1] = NULL;
+}
+#else
+Arduino_DMASPI::Arduino_DMASPI(int8_t dc, int8_t cs, SPIClass *spi, int8_t mosi)
+    : _dc(dc), _cs(cs), _spi(spi), _mosi(mosi), _spiReg(NULL), _pixel_frames(false), _async_data(NULL), _async_len(0), _repeat_color(0),
+      _dma_busy(false), _cs_release_pending(false), _done_cb(NULL), _done_arg(NULL), _fill_buf(0)
+{
+  _buf[0] = _buf[1] = NULL;
+}
+#endif
+
+void Arduino_DMASPI::begin(int32_t speed, int8_t dataMode)
+{
+  _speed = (speed == GFX_NOT_DEFINED) ? SPI_DEFAULT_FREQ : speed;
+  _dataMode = dataMode;
+
+  pinMode(_dc, OUTPUT);
+  digitalWrite(_dc, HIGH); // Data mode
+  if (_cs != GFX_NOT_DEFINED)
+  {
+    pinMode(_cs, OUTPUT);
+    digitalWrite(_cs, HIGH); // Deselect
+  }
+
+#if defined(ESP32)
+  if (_dataMode == GFX_NOT_DEFINED)
+  {
+    _dataMode = SPI_MODE0;
+  }
+
+  spi_bus_config_t buscfg = {};
+  buscfg.mosi_io_num = _mosi;
+  buscfg.miso_io_num = -1;
+  buscfg.sclk_io_num = _sck;
+  buscfg.quadwp_io_num = -1;
+  buscfg.quadhd_io_num = -1;
+  buscfg.max_transfer_sz = DMASPI_MAX_TRANSFER_BYTES;
+  if (spi_bus_initialize(_host, &buscfg, SPI_DMA_CH_AUTO) != ESP_OK)
+  {
+    Serial.println(F("SPI bus initialization failed."));
+  }
+
+  spi_device_interface_config_t devcfg = {};
+  devcfg.clock_speed_hz = _speed;
+  devcfg.mode = _dataMode;
+  devcfg.spics_io_num = -1; // CS is held across transactions by beginWrite()/endWrite()
+  devcfg.queue_size = 2;
+  devcfg.flags = SPI_DEVICE_NO_DUMMY;
+  if (spi_bus_add_device(_host, &devcfg, &_handle) != ESP_OK)
+  {
+    Serial.println(F("SPI device add failed."));
+  }
+
+  _buf[0] = (uint16_t *)gfx_alloc(DMASPI_BUFFER_PIXELS * 2, GFX_MEM_INTERNAL);
+  _buf[1] = (uint16_t *)gfx_alloc(DMASPI_BUFFER_PIXELS * 2, GFX_MEM_INTERNAL);
+#else // STM32
+  if (_dataMode == GFX_NOT_DEFINED)
+  {
+    _dataMode = SPI_MODE2;
+  }
+
+  // the core sets the peripheral up in each beginWrite(), DMA then feeds its data register directly
+  _spi->begin();
+  _spiReg = (SPI_TypeDef *)pinmap_peripheral(digitalPinToPinName((_mosi == GFX_NOT_DEFINED) ? PIN_SPI_MOSI : _mosi), PinMap_SPI_MOSI);
+#if defined(STM32F1xx)
+  RCC->AHBENR |= RCC_AHBENR_DMA1EN;
+  _dmaISR = &DMA1->ISR;
+  _dmaIFCR = &DMA1->IFCR;
+  if (_spiReg == SPI1)
+  {
+    _dmaCh = DMA1_Channel3;
+    _dmaShift = 8;
+  }
+#if defined(SPI2)
+  else if (_spiReg == SPI2)
+  {
+    _dmaCh = DMA1_Channel5;
+    _dmaShift = 16;
+  }
+#endif
+#else
+  if (_spiReg == SPI1)
+  {
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+    _dmaStream = DMA2_Stream3;
+    _dmaChannel = 3;
+    _dmaISR = &DMA2->LISR;
+    _dmaIFCR = &DMA2->LIFCR;
+    _dmaShift = 22;
+  }
+#if defined(SPI2)
+  else if (_spiReg == SPI2)
+  {
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    _dmaStream = DMA1_Stream4;
+    _dmaChannel = 0;
+    _dmaISR = &DMA1->HISR;
+    _dmaIFCR = &DMA1->HIFCR;
+    _dmaShift = 0;
+  }
+#endif
+#if defined(SPI3)
+  else if (_spiReg == SPI3)
+  {
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    _dmaStream = DMA1_Stream5;
+    _dmaChannel = 0;
+    _dmaISR = &DMA1->HISR;
+    _dmaIFCR = &DMA1->HIFCR;
+    _dmaShift = 6;
+  }
+#endif
+#endif
+  else
+  {
+    _spiReg = NULL;
+    Serial.println(F("No TX DMA for this SPI peripheral."));
+    return;
+  }
+
+  _buf[0] = (uint16_t *)gfx_alloc(DMASPI_BUFFER_PIXELS * 2, GFX_MEM_INTERNAL);
+  _buf[1] = (uint16_t *)gfx_alloc(DMASPI_BUFFER_PIXELS * 2, GFX_MEM_INTERNAL);
+#endif
+  if ((!_buf[0]) || (!_buf[1]))
+  {
+    Serial.println(F("_buf allocation failed."));
+  }
+}
+
+void Arduino_DMASPI::beginWrite()
+{
+  if (_cs_release_pending)
+  {
+    // previous write still draining, keep the panel selected
+    _cs_release_pending = false;
+    return;
+  }
+
+#if !defined(ESP32)
+  // the core may reinitialise the peripheral here, it comes back in 8-bit frames
+  _spi->beginTransaction(SPISettings(_speed, MSBFIRST, _dataMode));
+  _spiReg->CR1 &= ~SPI_CR1_DFF;
+  _pixel_frames = false;
+#endif
+  DC_HIGH();
+  CS_LOW();
+}
+
+void Arduino_DMASPI::endWrite()
+{
+  service();
+  if (_dma_busy)
+  {
+    // release CS once the transfer completes instead of waiting here
+    _cs_release_pending = true;
+  }
+  else
+  {
+    endBus();
+  }
+}
+
+// deselect the panel and hand the peripheral back to the core as it was found
+void Arduino_DMASPI::endBus()
+{
+  CS_HIGH();
+#if !defined(ESP32)
+  if (_pixel_frames)
+  {
+    _spiReg->CR1 &= ~SPI_CR1_SPE;
+    _spiReg->CR1 &= ~SPI_CR1_DFF;
+    _spiReg->CR1 |= SPI_CR1_SPE;
+    _pixel_frames = false;
+  }
+  _spi->endTransaction();
+#endif
+}
+
+void Arduino_DMASPI::writeCommand(uint8_t c)
+{
+  waitAsync();
+  DC_LOW();
+  writeSmall(&c, 1);
+  DC_HIGH();
+}
+
+void Arduino_DMASPI::writeCommand16(uint16_t c)
+{
+  uint8_t b[2] = {(uint8_t)(c >> 8), (uint8_t)c};
+  waitAsync();
+  DC_LOW();
+  writeSmall(b, 2);
+  DC_HIGH();
+}
+
+void Arduino_DMASPI::write(uint8_t d)
+{
+  writeSmall(&d, 1);
+}
+
+void Arduino_DMASPI::write16(uint16_t d)
+{
+  uint8_t b[2] = {(uint8_t)(d >> 8), (uint8_t)d};
+  writeSmall(b, 2);
+}
+
+void Arduino_DMASPI::writeRepeat(uint16_t p, uint32_t len)
+{
+  uint32_t xferLen;
+#if defined(ESP32)
+  // one buffer of the color is queued repeatedly
+  uint16_t *b = fillBuffer();
+  MSB_16_SET(p, p);
+  xferLen = (len < DMASPI_BUFFER_PIXELS) ? len : DMASPI_BUFFER_PIXELS;
+  for (uint32_t i = 0; i < xferLen; i++)
+  {
+    b[i] = p;
+  }
+  while (len)
+  {
+    xferLen = (len < DMASPI_BUFFER_PIXELS) ? len : DMASPI_BUFFER_PIXELS;
+    startDMA(b, xferLen, true, true);
+    len -= xferLen;
+  }
+  _fill_buf ^= 1;
+#else  // STM32
+  // 16-bit frames from a fixed source word, no buffer to fill at all
+  waitAsync();
+  _repeat_color = p;
+  while (len)
+  {
+    xferLen = (len < 0xFFFF) ? len : 0xFFFF;
+    startDMA(&_repeat_color, xferLen, true, false);
+    len -= xferLen;
+  }
+#endif
+}
+
+void Arduino_DMASPI::writePixels(uint16_t *data, uint32_t len)
+{
+  uint32_t xferLen;
+  uint16_t *b;
+#if !defined(ESP32)
+  if (len >= DMASPI_BUFFER_PIXELS)
+  {
+    // long runs go straight from the source in 16-bit frames, no staging copy
+    waitAsync();
+    while (len)
+    {
+      xferLen = (len < DMASPI_MAX_TRANSFER_BYTES) ? len : DMASPI_MAX_TRANSFER_BYTES;
+      startDMA(data, xferLen, true, true);
+      data += xferLen;
+      len -= xferLen;
+    }
+    // the caller may reuse data once this returns
+    waitAsync();
+    return;
+  }
+#endif
+  while (len)
+  {
+    // fill one buffer while DMA drains the other
+    xferLen = (len < DMASPI_BUFFER_PIXELS) ? len : DMASPI_BUFFER_PIXELS;
+    b = fillBuffer();
+#if defined(ESP32)
+    swapPixels(b, data, xferLen);
+    data += xferLen;
+#else  // STM32 sends 16-bit frames MSB first, no swap needed
+    memcpy(b, data, xferLen * 2);
+    data += xferLen;
+#endif
+    startDMA(b, xferLen, true, true);
+    _fill_buf ^= 1;
+    len -= xferLen;
+  }
+}
+
+void Arduino_DMASPI::writeBytes(uint8_t *data, uint32_t len)
+{
+  uint32_t xferLen;
+  uint8_t *b;
+  if ((len >= (DMASPI_BUFFER_PIXELS * 2)) && supportsZeroCopy(data, true))
+  {
+    waitAsync();
+    while (len)
+    {
+      xferLen = (len < DMASPI_MAX_TRANSFER_BYTES) ? len : DMASPI_MAX_TRANSFER_BYTES;
+#if defined(ESP32)
+      xferLen &= ~3UL; // keep every run word aligned
+      if (xferLen == 0)
+      {
+        xferLen = len;
+      }
+#endif
+      startDMA(data, xferLen, false, true);
+      data += xferLen;
+      len -= xferLen;
+    }
+    waitAsync();
+    return;
+  }
+  while (len)
+  {
+    xferLen = (len < (DMASPI_BUFFER_PIXELS * 2)) ? len : (DMASPI_BUFFER_PIXELS * 2);
+    b = (uint8_t *)fillBuffer();
+    memcpy(b, data, xferLen);
+    data += xferLen;
+    startDMA(b, xferLen, false, true);
+    _fill_buf ^= 1;
+    len -= xferLen;
+  }
+}
+
+void Arduino_DMASPI::writePattern(uint8_t *data, uint8_t len, uint32_t repeat)
+{
+#if !defined(ESP32)
+  if (len == 2)
+  {
+    // a 2 byte pattern is one 16-bit frame from a fixed source, like writeRepeat()
+    writeRepeat((data[0] << 8) | data[1], repeat);
+    return;
+  }
+#endif
+  uint32_t perBuf = len ? ((DMASPI_BUFFER_PIXELS * 2) / len) : 0;
+  if (perBuf < 2)
+  {
+    while (repeat--)
+    {
+      writeBytes(data, len);
+    }
+    return;
+  }
+
+  // whole copies of the pattern in one buffer, queued as often as needed
+  uint8_t *b = (uint8_t *)fillBuffer();
+  uint32_t copies = (repeat < perBuf) ? repeat : perBuf;
+  for (uint32_t i = 0; i < copies; i++)
+  {
+    memcpy(b + (i * len), data, len);
+  }
+  while (repeat)
+  {
+    copies = (repeat < perBuf) ? repeat : perBuf;
+    startDMA(b, copies * len, false, true);
+    repeat -= copies;
+  }
+  _fill_buf ^= 1;
+}
+
+// each chunk is looked up into one buffer while DMA sends the one before
+void Arduino_DMASPI::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  uint32_t xferLen;
+  uint16_t *b;
+  while (len)
+  {
+    xferLen = (len < DMASPI_BUFFER_PIXELS) ? len : DMASPI_BUFFER_PIXELS;
+    b = fillBuffer();
+    expandIndexedPixels(b, data, idx, xferLen);
+    startDMA(b, xferLen * 2, false, true);
+    _fill_buf ^= 1;
+    data += xferLen;
+    len -= xferLen;
+  }
+}
+
+void Arduino_DMASPI::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  uint32_t xferLen;
+  uint16_t *b;
+  while (len)
+  {
+    xferLen = (len < (DMASPI_BUFFER_PIXELS / 2)) ? len : (DMASPI_BUFFER_PIXELS / 2);
+    b = fillBuffer();
+    expandIndexedPixelsDouble(b, data, idx, xferLen);
+    startDMA(b, xferLen * 4, false, true);
+    _fill_buf ^= 1;
+    data += xferLen;
+    len -= xferLen;
+  }
+}
+
+/*!
+  @brief  Start sending pixels and return straight away. done(arg) is called
+          from isBusy(), waitAsync() or the next bus call once the transfer
+          has completed. On STM32 DMA reads data in place, so it must not be
+          changed until then; ESP32 swaps it into the ping-pong buffers first.
+*/
+void Arduino_DMASPI::writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t done, void *arg)
+{
+#if defined(ESP32)
+  writePixels(data, len);
+#else  // STM32
+  waitAsync();
+  uint32_t xferLen = (len < 0xFFFF) ? len : 0xFFFF;
+  _async_data = data + xferLen;
+  _async_len = len - xferLen;
+  if (xferLen)
+  {
+    startDMA(data, xferLen, true, true);
+  }
+#endif
+  if (!_dma_busy)
+  {
+    if (done)
+    {
+      done(arg);
+    }
+    return;
+  }
+  _done_cb = done;
+  _done_arg = arg;
+  service();
+}
+
+bool Arduino_DMASPI::supportsZeroCopy(const void *data, bool big_endian)
+{
+#if defined(ESP32)
+  // the ESP32 cannot swap bytes on the fly, big-endian data must also be DMA reachable
+  return big_endian && esp_ptr_dma_capable(data) && ((((uintptr_t)data) & 3) == 0);
+#else  // STM32 sends pixels as 16-bit frames and bytes as 8-bit frames
+  return big_endian || ((((uintptr_t)data) & 1) == 0);
+#endif
+}
+
+bool Arduino_DMASPI::isBusy()
+{
+  service();
+  return _dma_busy;
+}
+
+void Arduino_DMASPI::waitAsync()
+{
+  while (_dma_busy)
+  {
+#if defined(ESP32)
+    spi_transaction_t *rt;
+    if (_inflight && (spi_device_get_trans_result(_handle, &rt, portMAX_DELAY) == ESP_OK))
+    {
+      _inflight--;
+    }
+#endif
+    service();
+  }
+}
+
+// pick up completed transfers, chain the next run and finish the write
+void Arduino_DMASPI::service()
+{
+  if (!_dma_busy)
+  {
+    return;
+  }
+
+#if defined(ESP32)
+  spi_transaction_t *rt;
+  while (_inflight && (spi_device_get_trans_result(_handle, &rt, 0) == ESP_OK))
+  {
+    _inflight--;
+  }
+  if (_inflight)
+  {
+    return;
+  }
+#else  // STM32
+  if (!(*_dmaISR & DMASPI_TC_FLAG))
+  {
+    return;
+  }
+  *_dmaIFCR = DMASPI_ALL_FLAGS;
+  _dma_busy = false;
+  if (_async_len)
+  {
+    uint32_t xferLen = (_async_len < 0xFFFF) ? _async_len : 0xFFFF;
+    uint16_t *data = _async_data;
+    _async_data += xferLen;
+    _async_len -= xferLen;
+    startDMA(data, xferLen, true, true);
+    return;
+  }
+  // DMA is done once the last frame is in the data register, wait for it to shift out
+  while (_spiReg->SR & SPI_SR_BSY)
+  {
+  }
+  // core transfers poll the data register themselves
+  _spiReg->CR2 &= ~SPI_CR2_TXDMAEN;
+#endif
+
+  _dma_busy = false;
+  if (_cs_release_pending)
+  {
+    _cs_release_pending = false;
+    endBus();
+  }
+  if (_done_cb)
+  {
+    gfx_async_done_cb_t done = _done_cb;
+    _done_cb = NULL;
+    done(_done_arg);
+  }
+}
+
+// the buffer to fill next, the other one may still be draining
+uint16_t *Arduino_DMASPI::fillBuffer()
+{
+#if defined(ESP32)
+  spi_transaction_t *rt;
+  while ((_inflight >= 2) && (spi_device_get_trans_result(_handle, &rt, portMAX_DELAY) == ESP_OK))
+  {
+    _inflight--;
+  }
+#endif
+  return _buf[_fill_buf];
+}
+
+// queue one DMA run, waiting only while both buffers are in flight
+void Arduino_DMASPI::startDMA(const void *data, uint32_t len, bool pixels, bool increment)
+{
+#if defined(ESP32)
+  UNUSED(pixels);
+  UNUSED(increment);
+  spi_transaction_t *rt;
+  if (_inflight >= 2)
+  {
+    if (spi_device_get_trans_result(_handle, &rt, portMAX_DELAY) == ESP_OK)
+    {
+      _inflight--;
+    }
+  }
+  spi_transaction_t *t = &_trans[_next_trans];
+  _next_trans ^= 1;
+  memset(t, 0, sizeof(spi_transaction_t));
+  t->length = (pixels ? (len * 16) : (len * 8));
+  t->tx_buffer = data;
+  if (spi_device_queue_trans(_handle, t, portMAX_DELAY) == ESP_OK)
+  {
+    _inflight++;
+    _dma_busy = true;
+  }
+#else  // STM32
+  while (_dma_busy)
+  {
+    service();
+  }
+  SPI_TypeDef *spi = _spiReg;
+  if (pixels != _pixel_frames)
+  {
+    while (spi->SR & SPI_SR_BSY)
+    {
+    }
+    spi->CR1 &= ~SPI_CR1_SPE;
+    if (pixels)
+    {
+      spi->CR1 |= SPI_CR1_DFF;
+    }
+    else
+    {
+      spi->CR1 &= ~SPI_CR1_DFF;
+    }
+    spi->CR1 |= SPI_CR1_SPE;
+    _pixel_frames = pixels;
+  }
+  spi->CR2 |= SPI_CR2_TXDMAEN;
+
+#if defined(STM32F1xx)
+  DMA_Channel_TypeDef *ch = _dmaCh;
+  ch->CCR = 0;
+  *_dmaIFCR = DMASPI_ALL_FLAGS;
+  ch->CPAR = (uint32_t)&spi->DR;
+  ch->CMAR = (uint32_t)data;
+  ch->CNDTR = len;
+  ch->CCR = DMA_CCR_DIR |
+            (increment ? DMA_CCR_MINC : 0) |
+            (pixels ? (DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0) : 0) |
+            DMA_CCR_EN;
+#else
+  DMA_Stream_TypeDef *st = _dmaStream;
+  st->CR &= ~DMA_SxCR_EN;
+  while (st->CR & DMA_SxCR_EN)
+  {
+  }
+  *_dmaIFCR = DMASPI_ALL_FLAGS;
+  st->PAR = (uint32_t)&spi->DR;
+  st->M0AR = (uint32_t)data;
+  st->NDTR = len;
+  st->FCR = 0; // direct mode
+  st->CR = (_dmaChannel << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_DIR_0 |
+           (increment ? DMA_SxCR_MINC : 0) |
+           (pixels ? (DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0) : 0) |
+           DMA_SxCR_EN;
+#endif
+  _dma_busy = true;
+#endif
+}
+
+// command and parameter bytes are sent by the CPU once DMA has finished
+void Arduino_DMASPI::writeSmall(const uint8_t *data, uint8_t len)
+{
+  waitAsync();
+#if defined(ESP32)
+  spi_transaction_t t;
+  memset(&t, 0, sizeof(spi_transaction_t));
+  t.flags = SPI_TRANS_USE_TXDATA;
+  t.length = len * 8;
+  memcpy(t.tx_data, data, len);
+  spi_device_polling_transmit(_handle, &t);
+#else  // STM32
+  SPI_TypeDef *spi = _spiReg;
+  if (_pixel_frames)
+  {
+    spi->CR1 &= ~SPI_CR1_SPE;
+    spi->CR1 &= ~SPI_CR1_DFF;
+    spi->CR1 |= SPI_CR1_SPE;
+    _pixel_frames = false;
+  }
+  while (len--)
+  {
+    while (!(spi->SR & SPI_SR_TXE))
+    {
+    }
+    *(volatile uint8_t *)&spi->DR = *data++;
+  }
+  while (spi->SR & SPI_SR_BSY)
+  {
+  }
+#endif
+}
+
+/******** low level bit twiddling **********/
+
+INLINE void Arduino_DMASPI::DC_HIGH(void)
+{
+  digitalWrite(_dc, HIGH);
+}
+
+INLINE void Arduino_DMASPI::DC_LOW(void)
+{
+  digitalWrite(_dc, LOW);
+}
+
+INLINE void Arduino_DMASPI::CS_HIGH(void)
+{
+  if (_cs != GFX_NOT_DEFINED)
+  {
+    digitalWrite(_cs, HIGH);
+  }
+}
+
+INLINE void Arduino_DMASPI::CS_LOW(void)
+{
+  if (_cs != GFX_NOT_DEFINED)
+  {
+    digitalWrite(_cs, LOW);
+  }
+}
+
+#endif // defined(ESP32) || (defined(ARDUINO_ARCH_STM32) && (defined(STM32F1xx) || defined(STM32F4xx)))
@@ -0,0 +1,120 @@
+/*
+ * DMA driven SPI bus for ESP32 (ESP-IDF spi_master) and STM32F1/F4 (SPI TX DMA)
+ */
+#include "Arduino_DataBus.h"
+
+#if defined(ESP32) || (defined(ARDUINO_ARCH_STM32) && (defined(STM32F1xx) || defined(STM32F4xx)))
+
+#ifndef _ARDUINO_DMASPI_H_
+#define _ARDUINO_DMASPI_H_
+
+#include <SPI.h>
+#if defined(ESP32)
+#include "driver/spi_master.h"
+#include "esp_heap_caps.h"
+#if __has_include("esp_memory_utils.h")
+#include "esp_memory_utils.h"
+#else
+#include "soc/soc_memory_layout.h"
+#endif
+#endif
+
+#ifndef DMASPI_BUFFER_PIXELS
+#define DMASPI_BUFFER_PIXELS 256 // pixels in each of the two ping-pong buffers
+#endif
+#if defined(ESP32)
+#define DMASPI_MAX_TRANSFER_BYTES 32768 // longest zero-copy run queued at once
+#else
+#define DMASPI_MAX_TRANSFER_BYTES 0xFFFF // DMA count register limit, in frames
+#endif
+
+#if defined(ESP32)
+#if CONFIG_IDF_TARGET_ESP32C3
+#define DMASPI_DEFAULT_HOST SPI2_HOST
+#else
+#define DMASPI_DEFAULT_HOST SPI3_HOST
+#endif
+#endif
+
+class Arduino_DMASPI : public Arduino_DataBus
+{
+public:
+#if defined(ESP32)
+  Arduino_DMASPI(int8_t dc, int8_t cs, int8_t sck, int8_t mosi, spi_host_device_t host = DMASPI_DEFAULT_HOST); // Constructor
+#else
+  // mosi finds the SPI peripheral of spi, PIN_SPI_MOSI by default. SPI1 and
+  // SPI2 have TX DMA on F1, SPI1 to SPI3 on F4.
+  Arduino_DMASPI(int8_t dc, int8_t cs = GFX_NOT_DEFINED, SPIClass *spi = &SPI, int8_t mosi = GFX_NOT_DEFINED); // Constructor
+#endif
+
+  void begin(int32_t speed = GFX_NOT_DEFINED, int8_t dataMode = GFX_NOT_DEFINED) override;
+  void beginWrite() override;
+  void endWrite() override;
+  void writeCommand(uint8_t) override;
+  void writeCommand16(uint16_t) override;
+  void write(uint8_t) override;
+  void write16(uint16_t) override;
+  void writeRepeat(uint16_t p, uint32_t len) override;
+  void writePixels(uint16_t *data, uint32_t len) override;
+  void writeBytes(uint8_t *data, uint32_t len) override;
+  void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) override;
+  void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
+  void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
+
+  bool supportsZeroCopy(const void *data, bool big_endian) override;
+  bool supportsAsync() override { return true; }
+  void writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t done = NULL, void *arg = NULL) override;
+  bool isBusy() override;
+  void waitAsync() override;
+
+protected:
+  void service();
+  uint16_t *fillBuffer();
+  void startDMA(const void *data, uint32_t len, bool pixels, bool increment);
+  void writeSmall(const uint8_t *data, uint8_t len);
+  void endBus();
+  INLINE void DC_HIGH(void);
+  INLINE void DC_LOW(void);
+  INLINE void CS_HIGH(void);
+  INLINE void CS_LOW(void);
+
+private:
+  int8_t _dc, _cs;
+#if defined(ESP32)
+  int8_t _sck, _mosi;
+  spi_host_device_t _host;
+  spi_device_handle_t _handle;
+  spi_transaction_t _trans[2];
+  uint8_t _inflight;
+  uint8_t _next_trans;
+#else
+  SPIClass *_spi;
+  int8_t _mosi;
+  SPI_TypeDef *_spiReg;
+#if defined(STM32F1xx)
+  DMA_Channel_TypeDef *_dmaCh;
+#else
+  DMA_Stream_TypeDef *_dmaStream;
+  uint32_t _dmaChannel;
+#endif
+  volatile uint32_t *_dmaISR;
+  volatile uint32_t *_dmaIFCR;
+  uint8_t _dmaShift; // of the channel's or stream's flags in ISR/IFCR
+  bool _pixel_frames;
+  // remainder of a zero-copy async transfer longer than one DMA run
+  uint16_t *_async_data;
+  uint32_t _async_len;
+  uint16_t _repeat_color;
+#endif
+  bool _dma_busy;
+  bool _cs_release_pending;
+  gfx_async_done_cb_t _done_cb;
+  void *_done_arg;
+
+  uint16_t *_buf[2];
+  uint8_t _fill_buf;
+};
+
+#endif // _ARDUINO_DMASPI_H_
+
+#endif // defined(ESP32) || (defined(ARDUINO_ARCH_STM32) && (defined(STM32F1xx) || defined(STM32F4xx)))
@@ -3,6 +3,7 @@
  * https://github.com/lovyan03/LovyanGFX/blob/master/src/lgfx/v0/platforms/LGFX_PARALLEL_ESP32.hpp
  */
 #include "Arduino_ESP32LCD16.h"
+#include "Arduino_GFX_Alloc.h"
 
 #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32S3)
 
@@ -133,7 +134,7 @@ void Arduino_ESP32LCD16::begin(int32_t speed, int8_t dataMode)
   LCD_CAM.lcd_clock.val = lcd_clock.val;
 
   _dma_chan = _i80_bus->dma_chan;
-  _dmadesc = (dma_descriptor_t *)heap_caps_malloc(sizeof(dma_descriptor_t), MALLOC_CAP_DMA);
+  _dmadesc = (dma_descriptor_t *)gfx_alloc(sizeof(dma_descriptor_t), GFX_MEM_INTERNAL);
 }
 
 void Arduino_ESP32LCD16::beginWrite()
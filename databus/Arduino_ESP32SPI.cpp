@@ -584,13 +584,29 @@ void Arduino_ESP32SPI::writePixels(uint16_t *data, uint32_t len)
 #if CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32
       MISO_BIT_LEN = 0;
 #endif
+      bool aligned = ((((uintptr_t)data) & 3) == 0);
+      uint32_t v;
       while (len >= 32)
       {
-        for (uint8_t i = 0; i < 16; i++)
+        if (aligned)
         {
-          p1 = *data++;
-          p2 = *data++;
-          MSB_32_16_16_SET(_spi->dev->data_buf[i], p1, p2);
+          // two pixels per load, both swapped at once
+          uint32_t *p = (uint32_t *)data;
+          for (uint8_t i = 0; i < 16; i++)
+          {
+            v = *p++;
+            MSB_16_PAIR_SET(_spi->dev->data_buf[i], v);
+          }
+          data += 32;
+        }
+        else
+        {
+          for (uint8_t i = 0; i < 16; i++)
+          {
+            p1 = *data++;
+            p2 = *data++;
+            MSB_32_16_16_SET(_spi->dev->data_buf[i], p1, p2);
+          }
         }
 #if CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32S3
         _spi->dev->cmd.update = 1;
@@ -911,22 +927,22 @@ void Arduino_ESP32SPI::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t
       }
     }
 
-    if ((len > 0) && ((len % 2) == 0))
+    if (len > 1)
     {
       if (_data_buf_bit_idx > 0)
       {
         flush_data_buf();
       }
 
-      MOSI_BIT_LEN = (len * 16) - 1;
+      uint32_t pairs = len >> 1; // 2 pixels to a 32-bit data
+      MOSI_BIT_LEN = (pairs * 32) - 1;
 #if CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32
       MISO_BIT_LEN = 0;
 #endif
-      len >>= 1; // 2 pixels to a 32-bit data
-      for (uint32_t i = 0; i < len; i++)
+      for (uint32_t i = 0; i < pairs; i++)
       {
-        p1 = *data++;
-        p2 = *data++;
+        p1 = idx[*data++];
+        p2 = idx[*data++];
         MSB_32_16_16_SET(_spi->dev->data_buf[i], p1, p2);
       }
 #if CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32S3
@@ -936,13 +952,11 @@ void Arduino_ESP32SPI::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t
 #endif
       _spi->dev->cmd.usr = 1;
       WAIT_SPI_NOT_BUSY;
+      len &= 1;
     }
-    else
+    if (len)
     {
-      while (len--)
-      {
-        write16(*data++);
-      }
+      write16(idx[*data]);
     }
   }
 }
@@ -996,14 +1010,14 @@ void Arduino_ESP32SPI::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, ui
       }
     }
 
-    if ((len > 0) && ((len % 2) == 0))
+    if (len > 0)
     {
       if (_data_buf_bit_idx > 0)
       {
         flush_data_buf();
       }
 
-      MOSI_BIT_LEN = (len * 16) - 1;
+      MOSI_BIT_LEN = (len * 32) - 1; // each index is 2 pixels, one 32-bit data
 #if CONFIG_IDF_TARGET_ESP32S2 || CONFIG_IDF_TARGET_ESP32
       MISO_BIT_LEN = 0;
 #endif
@@ -1020,13 +1034,6 @@ void Arduino_ESP32SPI::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, ui
       _spi->dev->cmd.usr = 1;
       WAIT_SPI_NOT_BUSY;
     }
-    else
-    {
-      while (len--)
-      {
-        write16(*data++);
-      }
-    }
   }
 }
 
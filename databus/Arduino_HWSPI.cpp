@@ -3,6 +3,10 @@
  * https://github.com/adafruit/Adafruit-GFX-Library.git
  */
 #include "Arduino_HWSPI.h"
+#if defined(HWSPI_FAST_FILL) && defined(ARDUINO_ARCH_STM32)
+#include "PeripheralPins.h"
+#include "pinmap.h"
+#endif
 
 #if defined(SPI_HAS_TRANSACTION)
 #define SPI_BEGIN_TRANSACTION() _spi->beginTransaction(mySPISettings)
@@ -27,10 +31,18 @@ static uint8_t mySPCR;
 Arduino_HWSPI::Arduino_HWSPI(int8_t dc, int8_t cs /* = GFX_NOT_DEFINED */, int8_t sck /* = GFX_NOT_DEFINED */, int8_t mosi /* = GFX_NOT_DEFINED */, int8_t miso /* = GFX_NOT_DEFINED */, SPIClass *spi, bool is_shared_interface /* = true */)
     : _dc(dc), _cs(cs), _sck(sck), _mosi(mosi), _miso(miso), _spi(spi), _is_shared_interface(is_shared_interface)
 {
+#if defined(SPI_BUS_MANAGER)
+  _manager = NULL;
+  _device = GFX_NOT_DEFINED;
+#endif
 #else
 Arduino_HWSPI::Arduino_HWSPI(int8_t dc, int8_t cs /* = GFX_NOT_DEFINED */, SPIClass *spi, bool is_shared_interface /* = true */)
     : _dc(dc), _cs(cs), _spi(spi), _is_shared_interface(is_shared_interface)
 {
+#if defined(SPI_BUS_MANAGER)
+  _manager = NULL;
+  _device = GFX_NOT_DEFINED;
+#endif
 #endif
 }
 
@@ -174,6 +186,9 @@ void Arduino_HWSPI::begin(int32_t speed, int8_t dataMode)
     _dataMode = SPI_MODE2;
   }
   mySPISettings = SPISettings(_speed, MSBFIRST, _dataMode);
+#if defined(HWSPI_FAST_FILL) && defined(ARDUINO_ARCH_STM32)
+  _spiReg = (_spi == &SPI) ? (SPI_TypeDef *)pinmap_peripheral(digitalPinToPinName(PIN_SPI_MOSI), PinMap_SPI_MOSI) : NULL;
+#endif
 #elif defined(__AVR__) || defined(CORE_TEENSY)
   SPCRbackup = SPCR;
   _spi->begin();
@@ -199,10 +214,54 @@ void Arduino_HWSPI::begin(int32_t speed, int8_t dataMode)
     _dataMode = SPI_MODE2;
   }
 #endif
+
+#if defined(SPI_BUS_MANAGER)
+  if (_manager && (_device == GFX_NOT_DEFINED))
+  {
+    // the display drives its own cs, a slice without one could not be given up
+    _device = _manager->addDevice(_speed, _dataMode, (_cs == GFX_NOT_DEFINED) ? 0 : _slice_us);
+    if (_device == GFX_NOT_DEFINED)
+    {
+      _manager = NULL;
+    }
+  }
+#endif // defined(SPI_BUS_MANAGER)
 }
 
+#if defined(SPI_BUS_MANAGER)
+void Arduino_HWSPI::setBusManager(Arduino_SPIBusManager *manager, uint32_t slice_us)
+{
+  _manager = manager;
+  _slice_us = slice_us;
+}
+
+bool Arduino_HWSPI::sliced(uint32_t len)
+{
+  return _manager && _slice_us && (len > HWSPI_SLICE_PIXELS);
+}
+
+// between two pieces of a long write, hand over the bus if another device waits
+void Arduino_HWSPI::yieldPoint()
+{
+  if (_manager->shouldYield(_device))
+  {
+    CS_HIGH();
+    _manager->yieldBus(_device);
+    DC_HIGH();
+    CS_LOW();
+  }
+}
+#endif // defined(SPI_BUS_MANAGER)
+
 void Arduino_HWSPI::beginWrite()
 {
+#if defined(SPI_BUS_MANAGER)
+  if (_manager)
+  {
+    _manager->acquireWait(_device); // never select the panel without the bus
+  }
+  else
+#endif // defined(SPI_BUS_MANAGER)
   if (_is_shared_interface)
   {
     SPI_BEGIN_TRANSACTION();
@@ -216,6 +275,13 @@ void Arduino_HWSPI::endWrite()
 {
   CS_HIGH();
 
+#if defined(SPI_BUS_MANAGER)
+  if (_manager)
+  {
+    _manager->release(_device);
+  }
+  else
+#endif // defined(SPI_BUS_MANAGER)
   if (_is_shared_interface)
   {
     SPI_END_TRANSACTION();
@@ -264,14 +330,42 @@ void Arduino_HWSPI::write16(uint16_t d)
 
 void Arduino_HWSPI::writeRepeat(uint16_t p, uint32_t len)
 {
-#if defined(LITTLE_FOOT_PRINT)
+#if defined(SPI_BUS_MANAGER)
+  if (sliced(len))
+  {
+    while (len > HWSPI_SLICE_PIXELS)
+    {
+      writeRepeat(p, HWSPI_SLICE_PIXELS);
+      len -= HWSPI_SLICE_PIXELS;
+      yieldPoint();
+    }
+  }
+#endif // defined(SPI_BUS_MANAGER)
+#if defined(__AVR__)
+  _data16.value = p;
+  WRITEREPEAT(_data16.msb, _data16.lsb, len);
+#elif defined(LITTLE_FOOT_PRINT)
   _data16.value = p;
   while (len--)
   {
     WRITE(_data16.msb);
     WRITE(_data16.lsb);
   }
-#elif defined(ESP8266) || defined(CONFIG_ARCH_CHIP_CXD56XX)
+#else  // !defined(LITTLE_FOOT_PRINT)
+#if defined(HWSPI_FAST_FILL)
+  if (_spiReg)
+  {
+    _data16.value = p;
+    WRITEREPEAT(_data16.msb, _data16.lsb, len);
+    return;
+  }
+#endif // defined(HWSPI_FAST_FILL)
+#if defined(ESP8266) || defined(ESP32)
+  // the core repeats the pattern straight into the SPI FIFO
+  MSB_16_SET(p, p);
+  _spi->writePattern((uint8_t *)&p, 2, len);
+#elif defined(HWSPI_WRITEBUF_KEEPS_DATA)
+  // the buffer is filled once and sent as often as needed
   MSB_16_SET(p, p);
   uint32_t xferLen = (len < SPI_MAX_PIXELS_AT_ONCE) ? len : SPI_MAX_PIXELS_AT_ONCE;
   for (uint32_t i = 0; i < xferLen; i++)
@@ -304,10 +398,23 @@ void Arduino_HWSPI::writeRepeat(uint16_t p, uint32_t len)
     WRITEBUF(_buffer.v8, xferLen);
   }
 #endif // other arch
+#endif // !defined(LITTLE_FOOT_PRINT)
 }
 
 void Arduino_HWSPI::writePixels(uint16_t *data, uint32_t len)
 {
+#if defined(SPI_BUS_MANAGER)
+  if (sliced(len))
+  {
+    while (len > HWSPI_SLICE_PIXELS)
+    {
+      writePixels(data, HWSPI_SLICE_PIXELS);
+      data += HWSPI_SLICE_PIXELS;
+      len -= HWSPI_SLICE_PIXELS;
+      yieldPoint();
+    }
+  }
+#endif // defined(SPI_BUS_MANAGER)
 #if defined(LITTLE_FOOT_PRINT)
   while (len--)
   {
@@ -315,28 +422,16 @@ void Arduino_HWSPI::writePixels(uint16_t *data, uint32_t len)
     WRITE(_data16.msb);
     WRITE(_data16.lsb);
   }
+#elif defined(ESP32)
+  // the core swaps to MSB first on the way into the SPI FIFO, no staging copy
+  _spi->writePixels(data, len * 2);
 #else  // !defined(LITTLE_FOOT_PRINT)
   uint32_t xferLen;
-  uint8_t *b;
-  union
-  {
-    uint16_t val;
-    struct
-    {
-      uint8_t lsb;
-      uint8_t msb;
-    };
-  } t;
   while (len)
   {
     xferLen = (len < SPI_MAX_PIXELS_AT_ONCE) ? len : SPI_MAX_PIXELS_AT_ONCE;
-    b = _buffer.v8;
-    for (uint32_t i = 0; i < xferLen; i++)
-    {
-      t.val = *data++;
-      *b++ = t.msb;
-      *b++ = t.lsb;
-    }
+    swapPixels(_buffer.v16, data, xferLen);
+    data += xferLen;
     len -= xferLen;
 
     xferLen += xferLen; // uint16_t to uint8_t, double length
@@ -348,7 +443,32 @@ void Arduino_HWSPI::writePixels(uint16_t *data, uint32_t len)
 #if !defined(LITTLE_FOOT_PRINT)
 void Arduino_HWSPI::writeBytes(uint8_t *data, uint32_t len)
 {
+#if defined(SPI_BUS_MANAGER)
+  if (sliced(len / 2))
+  {
+    while (len > (HWSPI_SLICE_PIXELS * 2))
+    {
+      writeBytes(data, HWSPI_SLICE_PIXELS * 2);
+      data += HWSPI_SLICE_PIXELS * 2;
+      len -= HWSPI_SLICE_PIXELS * 2;
+      yieldPoint();
+    }
+  }
+#endif // defined(SPI_BUS_MANAGER)
+#if defined(HWSPI_WRITEBUF_KEEPS_DATA)
   WRITEBUF(data, len);
+#else  // !defined(HWSPI_WRITEBUF_KEEPS_DATA)
+  // stage through _buffer so the received bytes do not overwrite the caller's data
+  uint32_t xferLen;
+  while (len)
+  {
+    xferLen = (len < (SPI_MAX_PIXELS_AT_ONCE * 2)) ? len : (SPI_MAX_PIXELS_AT_ONCE * 2);
+    memcpy(_buffer.v8, data, xferLen);
+    WRITEBUF(_buffer.v8, xferLen);
+    data += xferLen;
+    len -= xferLen;
+  }
+#endif // !defined(HWSPI_WRITEBUF_KEEPS_DATA)
 }
 
 void Arduino_HWSPI::writePattern(uint8_t *data, uint8_t len, uint32_t repeat)
@@ -356,12 +476,58 @@ void Arduino_HWSPI::writePattern(uint8_t *data, uint8_t len, uint32_t repeat)
 #if defined(ESP8266) || defined(ESP32)
   _spi->writePattern(data, len, repeat);
 #else  // !(defined(ESP8266) || defined(ESP32))
-  while (repeat--)
+#if defined(HWSPI_FAST_FILL)
+  if (_spiReg && (len == 2))
+  {
+    WRITEREPEAT(data[0], data[1], repeat);
+    return;
+  }
+#endif // defined(HWSPI_FAST_FILL)
+  // as many whole copies as fit in _buffer go out with each WRITEBUF()
+  uint32_t perBuf = (len && (len <= sizeof(_buffer.v8))) ? (sizeof(_buffer.v8) / len) : 0;
+  if (perBuf < 2)
+  {
+    while (repeat--)
+    {
+      writeBytes(data, len);
+    }
+    return;
+  }
+
+  uint32_t copies;
+  bool filled = false;
+  while (repeat)
   {
-    WRITEBUF(data, len);
+    copies = (repeat < perBuf) ? repeat : perBuf;
+    if (!filled)
+    {
+      for (uint32_t i = 0; i < copies; i++)
+      {
+        memcpy(_buffer.v8 + (i * len), data, len);
+      }
+#if defined(HWSPI_WRITEBUF_KEEPS_DATA)
+      filled = true;
+#endif
+    }
+    WRITEBUF(_buffer.v8, copies * len);
+    repeat -= copies;
   }
 #endif // !(defined(ESP8266) || defined(ESP32))
 }
+
+bool Arduino_HWSPI::supportsZeroCopy(const void *data, bool big_endian)
+{
+  UNUSED(data);
+#if defined(ESP32)
+  UNUSED(big_endian);
+  return true;
+#elif defined(HWSPI_WRITEBUF_KEEPS_DATA)
+  return big_endian;
+#else
+  UNUSED(big_endian);
+  return false;
+#endif
+}
 #endif // !defined(LITTLE_FOOT_PRINT)
 
 INLINE void Arduino_HWSPI::WRITE(uint8_t d)
@@ -408,6 +574,15 @@ INLINE void Arduino_HWSPI::WRITEBUF(uint8_t *buf, size_t count)
   _spi->writeBytes(buf, count);
 #elif defined(CONFIG_ARCH_CHIP_CXD56XX)
   _spi->send(buf, count);
+#elif defined(ARDUINO_ARCH_STM32) && defined(SPI_TRANSMITONLY)
+  // the core takes a 16-bit length, a full frame of a 240x240 panel is 115200 bytes
+  while (count > 0xFFFF)
+  {
+    _spi->transfer(buf, 0xFFFF, SPI_TRANSMITONLY);
+    buf += 0xFFFF;
+    count -= 0xFFFF;
+  }
+  _spi->transfer(buf, count, SPI_TRANSMITONLY);
 #else  // other arch.
   _spi->transfer(buf, count);
 #endif // other arch.
@@ -415,6 +590,75 @@ INLINE void Arduino_HWSPI::WRITEBUF(uint8_t *buf, size_t count)
 
 #endif // !defined(LITTLE_FOOT_PRINT)
 
+#if defined(HWSPI_FAST_FILL)
+/*!
+  @brief  Send hi, lo len times. The data register is written again as soon
+          as it can take the next byte, the loop counting happens while the
+          current one shifts out, so the clock never stops between pixels.
+*/
+INLINE void Arduino_HWSPI::WRITEREPEAT(uint8_t hi, uint8_t lo, uint32_t len)
+{
+  if (!len)
+  {
+    return;
+  }
+#if defined(__AVR__)
+#if !defined(SPI_HAS_TRANSACTION)
+  SPCRbackup = SPCR;
+  SPCR = mySPCR;
+#endif
+  // SPIF is cleared by reading SPSR and then writing SPDR
+  SPDR = hi;
+  while (true)
+  {
+    while (!(SPSR & _BV(SPIF)))
+    {
+    }
+    SPDR = lo;
+    if (!--len)
+    {
+      break;
+    }
+    while (!(SPSR & _BV(SPIF)))
+    {
+    }
+    SPDR = hi;
+  }
+  while (!(SPSR & _BV(SPIF)))
+  {
+  }
+  (void)SPDR;
+#if !defined(SPI_HAS_TRANSACTION)
+  SPCR = SPCRbackup;
+#endif
+#else  // STM32
+  SPI_TypeDef *spi = _spiReg;
+  spi->CR1 |= SPI_CR1_SPE;
+  // TXE is set while the previous byte still shifts, the data register is double buffered
+  while (len--)
+  {
+    while (!(spi->SR & SPI_SR_TXE))
+    {
+    }
+    spi->DR = hi;
+    while (!(spi->SR & SPI_SR_TXE))
+    {
+    }
+    spi->DR = lo;
+  }
+  while (!(spi->SR & SPI_SR_TXE))
+  {
+  }
+  while (spi->SR & SPI_SR_BSY)
+  {
+  }
+  // drop the bytes received meanwhile and the overrun they caused
+  (void)spi->DR;
+  (void)spi->SR;
+#endif
+}
+#endif // defined(HWSPI_FAST_FILL)
+
 /******** low level bit twiddling **********/
 
 INLINE void Arduino_HWSPI::DC_HIGH(void)
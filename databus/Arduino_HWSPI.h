@@ -7,9 +7,24 @@
 
 #include <SPI.h>
 #include "Arduino_DataBus.h"
+#include "Arduino_SPIBusManager.h"
 
 #if !defined(LITTLE_FOOT_PRINT)
 #define SPI_MAX_PIXELS_AT_ONCE 32
+
+// WRITEBUF() sends without overwriting the source, other cores receive into it
+#if defined(ESP8266) || defined(ESP32) || defined(CONFIG_ARCH_CHIP_CXD56XX) || (defined(ARDUINO_ARCH_STM32) && defined(SPI_TRANSMITONLY))
+#define HWSPI_WRITEBUF_KEEPS_DATA
+#endif
+#endif
+
+// writeRepeat() loads the SPI data register itself, the next byte is ready before the shifter empties
+#if defined(__AVR__) || (defined(ARDUINO_ARCH_STM32) && (defined(STM32F1xx) || defined(STM32F4xx)))
+#define HWSPI_FAST_FILL
+#endif
+
+#if defined(SPI_BUS_MANAGER)
+#define HWSPI_SLICE_PIXELS 512 // pixels sent between checks for a waiting device
 #endif
 
 // HARDWARE CONFIG ---------------------------------------------------------
@@ -40,19 +55,32 @@ public:
 #if !defined(LITTLE_FOOT_PRINT)
   void writeBytes(uint8_t *data, uint32_t len) override;
   void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) override;
+  bool supportsZeroCopy(const void *data, bool big_endian) override;
 #endif // !defined(LITTLE_FOOT_PRINT)
 
+#if defined(SPI_BUS_MANAGER)
+  // Call before begin(). The display then takes the bus through the manager,
+  // and with a cs pin and a slice_us gives it up in the middle of long writes.
+  void setBusManager(Arduino_SPIBusManager *manager, uint32_t slice_us = 0);
+#endif // defined(SPI_BUS_MANAGER)
+
 private:
   INLINE void WRITE(uint8_t d);
 #if !defined(LITTLE_FOOT_PRINT)
   INLINE void WRITE16(uint16_t d);
   INLINE void WRITEBUF(uint8_t *buf, size_t count);
 #endif // !defined(LITTLE_FOOT_PRINT)
+#if defined(HWSPI_FAST_FILL)
+  INLINE void WRITEREPEAT(uint8_t hi, uint8_t lo, uint32_t len);
+#endif // defined(HWSPI_FAST_FILL)
   INLINE void DC_HIGH(void);
   INLINE void DC_LOW(void);
   INLINE void CS_HIGH(void);
   INLINE void CS_LOW(void);
-
+#if defined(SPI_BUS_MANAGER)
+  bool sliced(uint32_t len);
+  void yieldPoint();
+#endif // defined(SPI_BUS_MANAGER)
 
   int8_t _dc, _cs;
 #if defined(ESP32)
@@ -60,6 +88,14 @@ private:
 #endif
   SPIClass *_spi;
   bool _is_shared_interface;
+#if defined(HWSPI_FAST_FILL) && defined(ARDUINO_ARCH_STM32)
+  SPI_TypeDef *_spiReg; // NULL unless _spi is the default SPI
+#endif
+#if defined(SPI_BUS_MANAGER)
+  Arduino_SPIBusManager *_manager;
+  uint32_t _slice_us;
+  int8_t _device;
+#endif
 
   // CLASS INSTANCE VARIABLES --------------------------------------------
 
@@ -94,6 +130,7 @@ private:
   {
     uint8_t v8[SPI_MAX_PIXELS_AT_ONCE * 2] = {0};
     uint16_t v16[SPI_MAX_PIXELS_AT_ONCE];
+    uint32_t v32[SPI_MAX_PIXELS_AT_ONCE / 2]; // word aligned for swapPixels()
   } _buffer;
 #endif // !defined(LITTLE_FOOT_PRINT)
 };
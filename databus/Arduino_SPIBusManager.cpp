@@ -0,0 +1,173 @@
+/*
+ * Shares one SPI bus between several devices: cached settings per device,
+ * explicit transaction scopes and time slices for long transfers
+ */
+#include "Arduino_SPIBusManager.h"
+
+#if defined(SPI_BUS_MANAGER)
+
+Arduino_SPIBusManager::Arduino_SPIBusManager(SPIClass *spi)
+    : _spi(spi), _count(0), _owner(GFX_NOT_DEFINED), _depth(0), _since(0), _pending_count(0)
+{
+}
+
+int8_t Arduino_SPIBusManager::addDevice(int32_t speed, int8_t dataMode, uint32_t slice_us, int8_t cs)
+{
+  if (_count >= SPIBUSMANAGER_MAX_DEVICES)
+  {
+    Serial.println(F("SPI bus manager: no free device slot"));
+    return GFX_NOT_DEFINED;
+  }
+
+  Device *d = &_devices[_count];
+  d->settings = SPISettings((speed == GFX_NOT_DEFINED) ? SPI_DEFAULT_FREQ : speed, MSBFIRST, (dataMode == GFX_NOT_DEFINED) ? SPI_MODE0 : dataMode);
+  d->slice_us = slice_us;
+  d->service = NULL;
+  d->service_arg = NULL;
+  d->cs = cs;
+  d->pending = false;
+  if (cs != GFX_NOT_DEFINED)
+  {
+    pinMode(cs, OUTPUT);
+    digitalWrite(cs, HIGH); // Deselect
+  }
+  return _count++;
+}
+
+void Arduino_SPIBusManager::setService(int8_t id, spi_bus_service_cb_t cb, void *arg)
+{
+  _devices[id].service = cb;
+  _devices[id].service_arg = arg;
+}
+
+void Arduino_SPIBusManager::requestService(int8_t id)
+{
+  if (!_devices[id].pending)
+  {
+    _devices[id].pending = true;
+    _pending_count++;
+  }
+}
+
+// test and take the owner in one step, an interrupt or another task may want the bus too
+bool Arduino_SPIBusManager::acquire(int8_t id)
+{
+  noInterrupts();
+  if (_owner == id)
+  {
+    _depth++;
+    interrupts();
+    return true;
+  }
+  if (_owner != GFX_NOT_DEFINED)
+  {
+    interrupts();
+    return false;
+  }
+  _owner = id;
+  interrupts();
+
+  _depth = 1;
+  _since = micros();
+  select(id);
+  return true;
+}
+
+// the holder is another task or core, or an interrupt that has not released yet
+void Arduino_SPIBusManager::acquireWait(int8_t id)
+{
+  while (!acquire(id))
+  {
+    yield();
+  }
+}
+
+void Arduino_SPIBusManager::release(int8_t id)
+{
+  if ((_owner != id) || (--_depth))
+  {
+    return;
+  }
+
+  deselect(id);
+  _owner = GFX_NOT_DEFINED;
+  if (_pending_count)
+  {
+    runServices(id);
+  }
+}
+
+bool Arduino_SPIBusManager::shouldYield(int8_t id)
+{
+  return _pending_count && (_owner == id) && _devices[id].slice_us && ((micros() - _since) >= _devices[id].slice_us);
+}
+
+// the caller's chip select must already be released, its scope is restored afterwards
+void Arduino_SPIBusManager::yieldBus(int8_t id)
+{
+  if (_owner != id)
+  {
+    return;
+  }
+
+  uint8_t depth = _depth;
+  deselect(id);
+  _owner = GFX_NOT_DEFINED;
+  runServices(id);
+  _owner = id;
+  _depth = depth;
+  _since = micros();
+  select(id);
+}
+
+void Arduino_SPIBusManager::poll()
+{
+  if (_pending_count && (_owner == GFX_NOT_DEFINED))
+  {
+    runServices(GFX_NOT_DEFINED);
+  }
+}
+
+// each waiting device gets the bus once, in its own transaction
+void Arduino_SPIBusManager::runServices(int8_t except)
+{
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    Device *d = &_devices[i];
+    if ((i == except) || (!d->pending))
+    {
+      continue;
+    }
+    noInterrupts();
+    d->pending = false;
+    _pending_count--;
+    interrupts();
+    if (d->service)
+    {
+      acquire(i);
+      d->service(d->service_arg);
+      _depth = 1; // a service that forgot release() still hands the bus back
+      release(i);
+    }
+  }
+}
+
+void Arduino_SPIBusManager::select(int8_t id)
+{
+  _spi->beginTransaction(_devices[id].settings);
+  if (_devices[id].cs != GFX_NOT_DEFINED)
+  {
+    digitalWrite(_devices[id].cs, LOW);
+  }
+}
+
+void Arduino_SPIBusManager::deselect(int8_t id)
+{
+  if (_devices[id].cs != GFX_NOT_DEFINED)
+  {
+    digitalWrite(_devices[id].cs, HIGH);
+  }
+  _spi->endTransaction();
+}
+
+#endif // defined(SPI_BUS_MANAGER)
@@ -0,0 +1,79 @@
+/*
+ * Shares one SPI bus between several devices: cached settings per device,
+ * explicit transaction scopes and time slices for long transfers
+ */
+#include <SPI.h>
+#include "Arduino_DataBus.h"
+
+#if defined(SPI_HAS_TRANSACTION) && !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_SPIBUSMANAGER_H_
+#define _ARDUINO_SPIBUSMANAGER_H_
+
+#define SPI_BUS_MANAGER
+
+#ifndef SPIBUSMANAGER_MAX_DEVICES
+#define SPIBUSMANAGER_MAX_DEVICES 4
+#endif
+
+// Deferred work of a device, run by the manager once it can have the bus
+typedef void (*spi_bus_service_cb_t)(void *arg);
+
+class Arduino_SPIBusManager
+{
+public:
+  Arduino_SPIBusManager(SPIClass *spi = &SPI); // Constructor
+
+  // Returns the device id, or GFX_NOT_DEFINED when all slots are taken. A cs
+  // pin is driven by acquire()/release(), leave it out when the device does
+  // its own. slice_us is how long it may hold the bus while others wait, 0 is
+  // for ever.
+  int8_t addDevice(int32_t speed, int8_t dataMode, uint32_t slice_us = 0, int8_t cs = GFX_NOT_DEFINED);
+  void setService(int8_t id, spi_bus_service_cb_t cb, void *arg = NULL);
+  void requestService(int8_t id); // safe from an interrupt
+
+  // Transaction scope, nests for the same device. acquire() fails if another
+  // device holds the bus, acquireWait() waits for it instead. A plain SPI
+  // device, e.g. an EEPROM, is added with its cs pin and only transfers
+  // between acquire() and release().
+  bool acquire(int8_t id);
+  void acquireWait(int8_t id);
+  void release(int8_t id);
+
+  // For the holder between chunks of a long transfer: once its slice is used
+  // up and another device waits, deselect, call yieldBus(), then select again.
+  bool shouldYield(int8_t id);
+  void yieldBus(int8_t id);
+
+  void poll(); // runs waiting services while the bus is free
+  int8_t owner() { return _owner; }
+  SPIClass *spi() { return _spi; }
+
+protected:
+  void runServices(int8_t except);
+  void select(int8_t id);
+  void deselect(int8_t id);
+
+private:
+  struct Device
+  {
+    SPISettings settings;
+    uint32_t slice_us;
+    spi_bus_service_cb_t service;
+    void *service_arg;
+    int8_t cs;
+    volatile bool pending;
+  };
+
+  SPIClass *_spi;
+  Device _devices[SPIBUSMANAGER_MAX_DEVICES];
+  uint8_t _count;
+  volatile int8_t _owner;
+  uint8_t _depth;
+  uint32_t _since;
+  volatile uint8_t _pending_count;
+};
+
+#endif // _ARDUINO_SPIBUSMANAGER_H_
+
+#endif // defined(SPI_HAS_TRANSACTION) && !defined(LITTLE_FOOT_PRINT)
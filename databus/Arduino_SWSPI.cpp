@@ -252,6 +252,17 @@ void Arduino_SWSPI::begin(int32_t speed, int8_t dataMode)
   }
 #endif // !HAS_PORT_SET_CLR
 #endif // USE_FAST_PINIO
+
+#if defined(SWSPI_PORT_WRITES)
+#if defined(HAS_PORT_SET_CLR)
+  _sharedPort = (_mosiPortSet == _sckPortSet);
+#else  // !HAS_PORT_SET_CLR
+  _sharedPort = (_mosiPort == _sckPort);
+#endif // !HAS_PORT_SET_CLR
+#if defined(ARDUINO_ARCH_STM32)
+  _portBsrr = &(digitalPinToPort(_sck)->BSRR);
+#endif
+#endif // defined(SWSPI_PORT_WRITES)
 }
 
 void Arduino_SWSPI::beginWrite()
@@ -359,18 +370,38 @@ void Arduino_SWSPI::writeRepeat(uint16_t p, uint32_t len)
 
 void Arduino_SWSPI::writePixels(uint16_t *data, uint32_t len)
 {
-  while (len--)
+  if (_dc < 0) // 9-bit SPI
   {
-    WRITE16(*data++);
+    while (len--)
+    {
+      write16(*data++);
+    }
+  }
+  else
+  {
+    while (len--)
+    {
+      WRITE16(*data++);
+    }
   }
 }
 
 #if !defined(LITTLE_FOOT_PRINT)
 void Arduino_SWSPI::writeBytes(uint8_t *data, uint32_t len)
 {
-  while (len--)
+  if (_dc < 0) // 9-bit SPI
   {
-    WRITE(*data++);
+    while (len--)
+    {
+      WRITE9BITDATA(*data++);
+    }
+  }
+  else
+  {
+    while (len--)
+    {
+      WRITE(*data++);
+    }
   }
 }
 
@@ -378,14 +409,113 @@ void Arduino_SWSPI::writePattern(uint8_t *data, uint8_t len, uint32_t repeat)
 {
   while (repeat--)
   {
-    for (uint8_t i = 0; i < len; i++)
-    {
-      WRITE(data[i]);
-    }
+    writeBytes(data, len);
   }
 }
 #endif // !defined(LITTLE_FOOT_PRINT)
 
+#if defined(SWSPI_PORT_WRITES)
+// Each bit is the data with SCK low, then SCK high. The values for both
+// levels are worked out once per call, or once per byte on a plain port,
+// instead of read-modify-write per bit.
+#if defined(ARDUINO_ARCH_STM32)
+// BSRR sets MOSI and clears SCK in the same write
+#define SWSPI_PORT_SETUP()                                   \
+  volatile uint32_t *bsrr = _portBsrr;                       \
+  uint32_t sckHigh = _sckPinMaskSet;                         \
+  uint32_t bitOne = _mosiPinMaskSet | (_sckPinMaskSet << 16); \
+  uint32_t bitZero = (_mosiPinMaskSet | _sckPinMaskSet) << 16;
+#define SWSPI_PORT_BIT(b)           \
+  *bsrr = (b) ? bitOne : bitZero; \
+  *bsrr = sckHigh;
+#define SWSPI_PORT_END() *bsrr = sckHigh << 16;
+#define SWSPI_PORT_BYTE_BEGIN()
+#define SWSPI_PORT_BYTE_END()
+#elif defined(HAS_PORT_SET_CLR)
+// a zero bit clears MOSI with SCK, a one bit has to be set before SCK rises
+#define SWSPI_PORT_SETUP()                   \
+  PORTreg_t portSet = _sckPortSet;           \
+  PORTreg_t portClr = _sckPortClr;           \
+  ARDUINOGFX_PORT_t sck = _sckPinMask;       \
+  ARDUINOGFX_PORT_t mosi = _mosiPinMask;     \
+  ARDUINOGFX_PORT_t sckMosi = _sckPinMask | _mosiPinMask;
+#define SWSPI_PORT_BIT(b) \
+  if (b)                  \
+  {                       \
+    *portClr = sck;       \
+    *portSet = mosi;      \
+  }                       \
+  else                    \
+  {                       \
+    *portClr = sckMosi;   \
+  }                       \
+  *portSet = sck;
+#define SWSPI_PORT_END() *portClr = sck;
+#define SWSPI_PORT_BYTE_BEGIN()
+#define SWSPI_PORT_BYTE_END()
+#else // !HAS_PORT_SET_CLR
+// An interrupt may change the other pins of the port, so each byte reads the
+// port afresh with interrupts held off and leaves SCK low before letting go.
+#if defined(__AVR__)
+#define SWSPI_PORT_IRQ_OFF() \
+  uint8_t sreg = SREG;       \
+  cli();
+#define SWSPI_PORT_IRQ_RESTORE() SREG = sreg;
+#else
+#define SWSPI_PORT_IRQ_OFF() noInterrupts();
+#define SWSPI_PORT_IRQ_RESTORE() interrupts();
+#endif
+#define SWSPI_PORT_SETUP()   \
+  PORTreg_t port = _sckPort; \
+  ARDUINOGFX_PORT_t bitZero, bitOne, bitZeroClk, bitOneClk;
+#define SWSPI_PORT_BYTE_BEGIN()                            \
+  {                                                        \
+    SWSPI_PORT_IRQ_OFF()                                   \
+    bitZero = *port & _mosiPinMaskClr & _sckPinMaskClr;    \
+    bitOne = bitZero | _mosiPinMaskSet;                    \
+    bitZeroClk = bitZero | _sckPinMaskSet;                 \
+    bitOneClk = bitOne | _sckPinMaskSet;
+#define SWSPI_PORT_BYTE_END() \
+  *port = bitZero;            \
+  SWSPI_PORT_IRQ_RESTORE()    \
+  }
+#define SWSPI_PORT_BIT(b) \
+  if (b)                  \
+  {                       \
+    *port = bitOne;       \
+    *port = bitOneClk;    \
+  }                       \
+  else                    \
+  {                       \
+    *port = bitZero;      \
+    *port = bitZeroClk;   \
+  }
+#define SWSPI_PORT_END()
+#endif // !HAS_PORT_SET_CLR
+
+#if defined(LITTLE_FOOT_PRINT)
+#define SWSPI_PORT_SHIFT8(d)                       \
+  SWSPI_PORT_BYTE_BEGIN()                          \
+  for (uint8_t bit = 0x80; bit; bit >>= 1)         \
+  {                                                \
+    SWSPI_PORT_BIT((d)&bit)                        \
+  }                                                \
+  SWSPI_PORT_BYTE_END()
+#else // !defined(LITTLE_FOOT_PRINT)
+#define SWSPI_PORT_SHIFT8(d) \
+  SWSPI_PORT_BYTE_BEGIN()    \
+  SWSPI_PORT_BIT((d)&0x80)   \
+  SWSPI_PORT_BIT((d)&0x40)   \
+  SWSPI_PORT_BIT((d)&0x20)   \
+  SWSPI_PORT_BIT((d)&0x10)   \
+  SWSPI_PORT_BIT((d)&0x08)   \
+  SWSPI_PORT_BIT((d)&0x04)   \
+  SWSPI_PORT_BIT((d)&0x02)   \
+  SWSPI_PORT_BIT((d)&0x01)   \
+  SWSPI_PORT_BYTE_END()
+#endif // !defined(LITTLE_FOOT_PRINT)
+#endif // defined(SWSPI_PORT_WRITES)
+
 INLINE void Arduino_SWSPI::WRITE9BITCOMMAND(uint8_t c)
 {
   // D/C bit, command
@@ -436,6 +566,16 @@ INLINE void Arduino_SWSPI::WRITE9BITDATA(uint8_t d)
 
 INLINE void Arduino_SWSPI::WRITE(uint8_t d)
 {
+#if defined(SWSPI_PORT_WRITES)
+  if (_sharedPort)
+  {
+    SWSPI_PORT_SETUP();
+    SWSPI_PORT_SHIFT8(d);
+    SWSPI_PORT_END();
+    return;
+  }
+#endif // defined(SWSPI_PORT_WRITES)
+
   uint8_t bit = 0x80;
   while (bit)
   {
@@ -455,6 +595,19 @@ INLINE void Arduino_SWSPI::WRITE(uint8_t d)
 
 INLINE void Arduino_SWSPI::WRITE16(uint16_t d)
 {
+#if defined(SWSPI_PORT_WRITES)
+  if (_sharedPort)
+  {
+    uint8_t hi = d >> 8;
+    uint8_t lo = d;
+    SWSPI_PORT_SETUP();
+    SWSPI_PORT_SHIFT8(hi);
+    SWSPI_PORT_SHIFT8(lo);
+    SWSPI_PORT_END();
+    return;
+  }
+#endif // defined(SWSPI_PORT_WRITES)
+
   uint16_t bit = 0x8000;
   while (bit)
   {
@@ -497,6 +650,23 @@ INLINE void Arduino_SWSPI::WRITE9BITREPEAT(uint16_t p, uint32_t len)
 
 INLINE void Arduino_SWSPI::WRITEREPEAT(uint16_t p, uint32_t len)
 {
+#if defined(SWSPI_PORT_WRITES)
+  if (_sharedPort)
+  {
+    // any color: the port values are set up once for the whole run
+    uint8_t hi = p >> 8;
+    uint8_t lo = p;
+    SWSPI_PORT_SETUP();
+    while (len--)
+    {
+      SWSPI_PORT_SHIFT8(hi);
+      SWSPI_PORT_SHIFT8(lo);
+    }
+    SWSPI_PORT_END();
+    return;
+  }
+#endif // defined(SWSPI_PORT_WRITES)
+
   if ((p == 0x0000) || (p == 0xffff)) // no need to set MOSI level while filling black or white
   {
     if (p)
@@ -7,6 +7,11 @@
 
 #include "Arduino_DataBus.h"
 
+// MOSI and SCK on the same port are driven with whole-register writes of precomputed values
+#if defined(USE_FAST_PINIO) && !defined(CORE_TEENSY)
+#define SWSPI_PORT_WRITES
+#endif
+
 class Arduino_SWSPI : public Arduino_DataBus
 {
 public:
@@ -90,6 +95,12 @@ private:
   ARDUINOGFX_PORT_t _misoPinMask; ///< Bitmask for MISO
 #endif                            // !KINETISK
 #endif                            // defined(USE_FAST_PINIO)
+#if defined(SWSPI_PORT_WRITES)
+  bool _sharedPort; ///< MOSI and SCK on the same port
+#if defined(ARDUINO_ARCH_STM32)
+  volatile uint32_t *_portBsrr; ///< Set/reset register of that port
+#endif
+#endif // defined(SWSPI_PORT_WRITES)
 };
 
 #endif // _ARDUINO_SWSPI_H_
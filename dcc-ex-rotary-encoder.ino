@@ -105,6 +105,13 @@ If knob mode defined, include the required libraries.
 #define BLINK_RATE 500
 #endif
 
+/*
+* If turntable bridge width not set, set it
+*/
+#ifndef TURNTABLE_WIDTH
+#define TURNTABLE_WIDTH 5
+#endif
+
 /*
 Include required libraries and files.
 */
@@ -204,12 +211,50 @@ uint16_t turntableAngle = HOME_ANGLE;   // Start display with turntable at home
 char textChars[11];     // Stores the current position text
 
 // Instantiate DataBus and GFX objects.
-#ifdef ARDUINO_ARCH_ESP32
+#if defined(GC9A01_DMA) && defined(ARDUINO_ARCH_ESP32)
+Arduino_DataBus *bus = new Arduino_DMASPI(GC9A01_DC, GC9A01_CS, GC9A01_CLK, GC9A01_DIN);
+#elif defined(GC9A01_DMA) && (defined(STM32F1xx) || defined(STM32F4xx))
+Arduino_DataBus *bus = new Arduino_DMASPI(GC9A01_DC, GC9A01_CS);
+#elif defined(ARDUINO_ARCH_ESP32)
 Arduino_DataBus *bus = new Arduino_ESP32SPI(GC9A01_DC, GC9A01_CS, GC9A01_CLK, GC9A01_DIN, GFX_NOT_DEFINED, VSPI);
 #else
 Arduino_DataBus *bus = new Arduino_HWSPI(GC9A01_DC, GC9A01_CS);
 #endif
+#if defined(GC9A01_BATCH) && !defined(LITTLE_FOOT_PRINT)
+Arduino_GFX *gfx = new Arduino_GC9A01(new Arduino_BatchBus(bus), GC9A01_RST, GC9A01_ROTATION, GC9A01_IPS);
+#else
 Arduino_GFX *gfx = new Arduino_GC9A01(bus, GC9A01_RST, GC9A01_ROTATION, GC9A01_IPS);
+#endif
+
+#if defined(GC9A01_AUTO_SPEED) && !defined(LITTLE_FOOT_PRINT)
+// SPI clocks tried at start-up, slowest first so that a clock the core
+// cannot reach does not win a tie against one it can
+static const int32_t displaySpeeds[] = {20000000, 40000000, 80000000};
+static const char *displaySpeedNames[] = {"SPI 20 MHz", "SPI 40 MHz", "SPI 80 MHz"};
+#define DISPLAY_SPEED_EEPROM_ADDRESS 0
+int32_t displaySpeed = GFX_NOT_DEFINED;
+
+/*
+Function to pick the fastest SPI clock for the display with the bus benchmark.
+Where the core has EEPROM the choice is kept there, so it is measured once.
+*/
+int32_t selectDisplaySpeed() {
+  Arduino_BusBenchmark busBenchmark(gfx->width(), gfx->height());
+  for (uint8_t i = 0; i < sizeof(displaySpeeds) / sizeof(displaySpeeds[0]); i++) {
+    busBenchmark.addCandidate(displaySpeedNames[i], bus, displaySpeeds[i]);
+  }
+#if defined(BUSBENCHMARK_EEPROM)
+  if (busBenchmark.load(DISPLAY_SPEED_EEPROM_ADDRESS)) {
+    return busBenchmark.selectedSpeed();
+  }
+#endif
+  busBenchmark.select();
+#if defined(BUSBENCHMARK_EEPROM)
+  busBenchmark.save(DISPLAY_SPEED_EEPROM_ADDRESS);
+#endif
+  return busBenchmark.selectedSpeed();
+}
+#endif
 
 // Define radians for angle calculation
 #define ONE_DEGREE_RADIAN 0.01745329
@@ -341,13 +386,23 @@ void drawTurntable(uint16_t angle) {
   hy0 = y * indicatorInner + displayCentre;
   hx1 = x * indicatorOuter + displayCentre;
   hy1 = y * indicatorOuter + displayCentre;
-  gfx->drawLine(lastX0, lastY0, lastX1, lastY1, BACKGROUND_COLOUR);
+#if TURNTABLE_WIDTH > 1
+  // Erase the old indicator first, moving the bridge redraws anything it cut through
   gfx->drawLine(lastHX0, lastHY0, lastHX1, lastHY1, BACKGROUND_COLOUR);
   if (moving && blinkFlag == 0) {
-    gfx->drawLine(x0, y0, x1, y1, BACKGROUND_COLOUR);
+    gfx->moveThickLine(lastX0, lastY0, lastX1, lastY1, x0, y0, x1, y1, TURNTABLE_WIDTH, BACKGROUND_COLOUR, BACKGROUND_COLOUR);
   } else {
-    gfx->drawLine(x0, y0, x1, y1, TURNTABLE_COLOUR);
+    gfx->moveThickLine(lastX0, lastY0, lastX1, lastY1, x0, y0, x1, y1, TURNTABLE_WIDTH, TURNTABLE_COLOUR, BACKGROUND_COLOUR);
   }
+#else
+  gfx->drawAntialiasedLine(lastX0, lastY0, lastX1, lastY1, BACKGROUND_COLOUR, BACKGROUND_COLOUR);
+  gfx->drawLine(lastHX0, lastHY0, lastHX1, lastHY1, BACKGROUND_COLOUR);
+  if (moving && blinkFlag == 0) {
+    gfx->drawAntialiasedLine(x0, y0, x1, y1, BACKGROUND_COLOUR, BACKGROUND_COLOUR);
+  } else {
+    gfx->drawAntialiasedLine(x0, y0, x1, y1, TURNTABLE_COLOUR, BACKGROUND_COLOUR);
+  }
+#endif
   gfx->drawLine(hx0, hy0, hx1, hy1, homeEndColour);
   lastX0 = x0;
   lastY0 = y0;
@@ -472,6 +527,18 @@ void disableJTAG() {
 void setup() {
 #if  defined(ARDUINO_BLUEPILL_F103C8)
   disableJTAG();
+#endif
+#if MODE == TURNTABLE
+  // Panel reset and init delays run while the rest of setup() does its work,
+  // AVR builds have no async begin and init the panel here
+#if defined(GC9A01_AUTO_SPEED) && !defined(LITTLE_FOOT_PRINT)
+  displaySpeed = selectDisplaySpeed();
+  gfx->beginAsync(displaySpeed);
+#elif !defined(LITTLE_FOOT_PRINT)
+  gfx->beginAsync();
+#else
+  gfx->begin();
+#endif
 #endif
   Serial.begin(115200);
   Serial.print(F("DCC-EX Rotary Encoder "));
@@ -508,8 +575,34 @@ void setup() {
   displaySelectedPosition(counter);
 #endif
 #if MODE == TURNTABLE
-  gfx->begin();
+#if !defined(LITTLE_FOOT_PRINT)
+  while (!gfx->beginPoll()) {
+  }
+#endif
+#ifdef DIAG
+#if defined(GC9A01_AUTO_SPEED) && !defined(LITTLE_FOOT_PRINT)
+  Serial.print(F("Display SPI clock: "));
+  Serial.println(displaySpeed);
+#endif
+#if !defined(LITTLE_FOOT_PRINT)
+  // Throughput of the display bus for fills, pixel data and small windows
+  gfx_bus_benchmark_t busResult;
+  Arduino_BusBenchmark busBenchmark(gfx->width(), gfx->height());
+  busBenchmark.run(bus, &busResult);
+  busBenchmark.print("Display bus", &busResult);
+#endif
+  // Full screen fill time, the SPI bound is width * height * 16 clocks
+  unsigned long fillStart = micros();
+  gfx->fillScreen(BACKGROUND_COLOUR);
+  unsigned long fillTime = micros() - fillStart;
+  Serial.print(F("fillScreen: "));
+  Serial.print(fillTime);
+  Serial.print(F(" us, "));
+  Serial.print((uint32_t)gfx->width() * gfx->height() * 16 / fillTime);
+  Serial.println(F(" Mbit/s"));
+#else
   gfx->fillScreen(BACKGROUND_COLOUR);
+#endif
   pinMode(GC9A01_BL, OUTPUT);
   digitalWrite(GC9A01_BL, HIGH);
   displayWidth = gfx->width();
@@ -15,6 +15,14 @@ void Arduino_GC9A01::begin(int32_t speed)
   Arduino_TFT::begin(speed);
 }
 
+#if !defined(LITTLE_FOOT_PRINT)
+void Arduino_GC9A01::beginAsync(int32_t speed)
+{
+  _override_datamode = SPI_MODE0; // always use SPI_MODE0
+  Arduino_TFT::beginAsync(speed);
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 void Arduino_GC9A01::writeAddrWindow(int16_t x, int16_t y, uint16_t w, uint16_t h)
 {
   if ((x != _currentX) || (w != _currentW) || (y != _currentY) || (h != _currentH))
@@ -80,6 +88,13 @@ void Arduino_GC9A01::displayOff(void)
 
 void Arduino_GC9A01::tftInit()
 {
+#if !defined(LITTLE_FOOT_PRINT)
+  tftInitStart();
+  while (initWaiting() || (!tftInitPoll()))
+  {
+    delay(1);
+  }
+#else  // defined(LITTLE_FOOT_PRINT)
   if (_rst != GFX_NOT_DEFINED)
   {
     pinMode(_rst, OUTPUT);
@@ -101,4 +116,58 @@ void Arduino_GC9A01::tftInit()
   {
     _bus->sendCommand(GC9A01_INVON);
   }
+#endif // defined(LITTLE_FOOT_PRINT)
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+void Arduino_GC9A01::tftInitStart()
+{
+  if (_rst != GFX_NOT_DEFINED)
+  {
+    pinMode(_rst, OUTPUT);
+    digitalWrite(_rst, HIGH);
+    initWait(100);
+    _init_step = 0;
+  }
+  else
+  {
+    // Software Rest
+    _init_step = 2;
+  }
+}
+
+// The reset pulse and the script's DELAY steps return false instead of blocking
+bool Arduino_GC9A01::tftInitPoll()
+{
+  switch (_init_step)
+  {
+  case 0:
+    digitalWrite(_rst, LOW);
+    initWait(GC9A01_RST_DELAY);
+    _init_step = 1;
+    return false;
+  case 1:
+    digitalWrite(_rst, HIGH);
+    initWait(GC9A01_RST_DELAY);
+    _init_step = 2;
+    return false;
+  case 2:
+    _bus->batchOperationStart(gc9a01_init_operations, sizeof(gc9a01_init_operations));
+    _init_step = 3;
+    /* fall through */
+  case 3:
+    if (!_bus->batchOperationPoll())
+    {
+      return false;
+    }
+    if (_ips)
+    {
+      _bus->sendCommand(GC9A01_INVON);
+    }
+    _init_step = 4;
+    /* fall through */
+  default:
+    return true;
+  }
 }
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -48,7 +48,7 @@
 #define GC9A01_RDID3 0xDC
 #define GC9A01_RDID4 0xDD
 
-static const uint8_t gc9a01_init_operations[] = {
+static constexpr uint8_t gc9a01_init_operations[] = {
     BEGIN_WRITE,
 
     WRITE_COMMAND_8, 0xEF,
@@ -189,6 +189,9 @@ static const uint8_t gc9a01_init_operations[] = {
 
     DELAY, 20};
 
+static_assert(gfx_batch_operations_valid(gc9a01_init_operations, sizeof(gc9a01_init_operations)),
+              "gc9a01_init_operations has a step cut short");
+
 class Arduino_GC9A01 : public Arduino_TFT
 {
 public:
@@ -198,6 +201,9 @@ public:
       uint8_t col_offset1 = 0, uint8_t row_offset1 = 0, uint8_t col_offset2 = 0, uint8_t row_offset2 = 0);
 
   void begin(int32_t speed = GFX_NOT_DEFINED) override;
+#if !defined(LITTLE_FOOT_PRINT)
+  void beginAsync(int32_t speed = GFX_NOT_DEFINED) override;
+#endif // !defined(LITTLE_FOOT_PRINT)
   void writeAddrWindow(int16_t x, int16_t y, uint16_t w, uint16_t h) override;
   void setRotation(uint8_t r) override;
   void invertDisplay(bool) override;
@@ -206,6 +212,10 @@ public:
 
 protected:
   void tftInit() override;
+#if !defined(LITTLE_FOOT_PRINT)
+  void tftInitStart() override;
+  bool tftInitPoll() override;
+#endif // !defined(LITTLE_FOOT_PRINT)
 
 private:
 };
@@ -89,13 +89,12 @@ void Arduino_ILI9488_3bit::drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitm
   UNUSED(h);
 }
 
+// bitmap is already in the 3-bit interface format, 2 pixels per byte
 void Arduino_ILI9488_3bit::draw3bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h)
 {
-  UNUSED(x);
-  UNUSED(y);
   _bus->beginWrite();
-  writeAddrWindow(0, 0, w, h);
-  _bus->writeBytes(bitmap, w * h / 2);
+  writeAddrWindow(x, y, w, h);
+  _bus->writeBytes(bitmap, ((uint32_t)w * h + 1) / 2);
   _bus->endWrite();
 }
 
@@ -109,6 +108,16 @@ void Arduino_ILI9488_3bit::draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bi
   UNUSED(h);
 }
 
+void Arduino_ILI9488_3bit::draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+{
+  printf("Not Implemented draw16bitBeRGBBitmap()");
+  UNUSED(x);
+  UNUSED(y);
+  UNUSED(bitmap);
+  UNUSED(w);
+  UNUSED(h);
+}
+
 void Arduino_ILI9488_3bit::draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h)
 {
   printf("Not Implemented draw24bitRGBBitmap()");
@@ -0,0 +1,67 @@
+/*
+ * Just enough of the Arduino core to build the library on a PC, see run.sh
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+#define INPUT 0
+#define INPUT_PULLUP 2
+#define PROGMEM
+#define MSBFIRST 1
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper *)(s))
+
+// pin writes go to host_pin_hook when a test sets it
+extern void (*host_pin_hook)(int pin, int value);
+inline void pinMode(int, int) {}
+inline void digitalWrite(int pin, int value)
+{
+  if (host_pin_hook)
+  {
+    host_pin_hook(pin, value);
+  }
+}
+inline int digitalRead(int) { return 0; }
+
+// micros() follows the PC clock unless a test drives host_fake_micros
+extern bool host_fake_clock;
+extern unsigned long host_fake_micros;
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void yield() {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+class String : public std::string
+{
+public:
+  String(const char *s = "") : std::string(s) {}
+  unsigned int length() const { return size(); }
+};
+
+#include "Print.h"
+class HardwareSerial : public Print
+{
+public:
+  size_t write(uint8_t c) override { return putchar(c), 1; }
+  void begin(long) {}
+};
+extern HardwareSerial Serial;
+
+template <class T>
+T min(T a, T b) { return (a < b) ? a : b; }
+template <class T>
+T max(T a, T b) { return (a > b) ? a : b; }
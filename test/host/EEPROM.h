@@ -0,0 +1,81 @@
+/*
+ * Host stand-in for the EEPROM of the ESP32, ESP8266 and RP2040 cores: a RAM
+ * copy of flash that begin() allocates, commit() writes back and end() frees.
+ * host_eeprom_flash is what survives a reset.
+ */
+#pragma once
+#include "Arduino.h"
+
+#define BUSBENCHMARK_EEPROM_COMMIT // Arduino_BusBenchmark takes it for one of those cores
+
+#define HOST_EEPROM_FLASH 256
+extern uint8_t host_eeprom_flash[HOST_EEPROM_FLASH];
+
+class EEPROMClass
+{
+public:
+  uint32_t begins = 0, ends = 0, commits = 0;
+
+  bool begin(size_t size)
+  {
+    if ((size == 0) || (size > HOST_EEPROM_FLASH))
+    {
+      return false;
+    }
+    free(_data);
+    _data = (uint8_t *)malloc(size);
+    memcpy(_data, host_eeprom_flash, size);
+    _size = size;
+    begins++;
+    return true;
+  }
+  void end()
+  {
+    free(_data);
+    _data = NULL;
+    _size = 0;
+    ends++;
+  }
+  bool commit()
+  {
+    if (!_data)
+    {
+      return false;
+    }
+    memcpy(host_eeprom_flash, _data, _size);
+    commits++;
+    return true;
+  }
+  uint16_t length() { return _size; }
+  uint8_t read(int address) { return (_data && ((size_t)address < _size)) ? _data[address] : 0; }
+  void write(int address, uint8_t value)
+  {
+    if (_data && ((size_t)address < _size))
+    {
+      _data[address] = value;
+    }
+  }
+  template <typename T>
+  T &get(int address, T &t)
+  {
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+      ((uint8_t *)&t)[i] = read(address + i);
+    }
+    return t;
+  }
+  template <typename T>
+  const T &put(int address, const T &t)
+  {
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+      write(address + i, ((const uint8_t *)&t)[i]);
+    }
+    return t;
+  }
+
+private:
+  uint8_t *_data = NULL;
+  size_t _size = 0;
+};
+extern EEPROMClass EEPROM;
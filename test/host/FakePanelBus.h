@@ -0,0 +1,132 @@
+/*
+ * A data bus that plays a 240x240 GC9A01: CASET, RASET and RAMWR land in
+ * ram[] and every command and data byte is counted. zero_copy sets what
+ * supportsZeroCopy() reports, the bytes take the same path either way.
+ */
+#pragma once
+#include "Arduino_DataBus.h"
+
+#define FAKE_PANEL_SIZE 240
+
+class FakePanelBus : public Arduino_DataBus
+{
+public:
+  uint16_t ram[FAKE_PANEL_SIZE * FAKE_PANEL_SIZE];
+  uint32_t cmd_bytes = 0;
+  uint32_t data_bytes = 0;
+  uint32_t windows = 0;
+  uint32_t pixel_calls = 0; // writePixels() and writeBytes() calls
+  bool zero_copy = false;
+
+  FakePanelBus() { memset(ram, 0, sizeof(ram)); }
+
+  void begin(int32_t, int8_t) override {}
+  void beginWrite() override {}
+  void endWrite() override {}
+  void writeCommand(uint8_t c) override
+  {
+    _cmd = c;
+    _args = 0;
+    cmd_bytes++;
+    if (c == 0x2C) // RAMWR
+    {
+      _cx = _x0;
+      _cy = _y0;
+      _half = false;
+      windows++;
+    }
+  }
+  void writeCommand16(uint16_t c) override { writeCommand(c); }
+  void write(uint8_t d) override
+  {
+    if ((_cmd == 0x2A) || (_cmd == 0x2B)) // CASET, RASET
+    {
+      cmd_bytes++;
+      _arg[_args++ & 3] = d;
+      if (_args == 4)
+      {
+        int16_t a = (_arg[0] << 8) | _arg[1];
+        int16_t b = (_arg[2] << 8) | _arg[3];
+        if (_cmd == 0x2A)
+        {
+          _x0 = a;
+          _x1 = b;
+        }
+        else
+        {
+          _y0 = a;
+          _y1 = b;
+        }
+      }
+      return;
+    }
+    data_bytes++;
+    if (_cmd != 0x2C)
+    {
+      return;
+    }
+    if (!_half)
+    {
+      _hi = d;
+      _half = true;
+      return;
+    }
+    _half = false;
+    if ((_cy <= _y1) && (_cx < FAKE_PANEL_SIZE) && (_cy < FAKE_PANEL_SIZE))
+    {
+      ram[(_cy * FAKE_PANEL_SIZE) + _cx] = (_hi << 8) | d;
+    }
+    if (++_cx > _x1)
+    {
+      _cx = _x0;
+      _cy++;
+    }
+  }
+  void write16(uint16_t d) override
+  {
+    write(d >> 8);
+    write(d);
+  }
+  void writeRepeat(uint16_t p, uint32_t len) override
+  {
+    while (len--)
+    {
+      write16(p);
+    }
+  }
+  void writePixels(uint16_t *data, uint32_t len) override
+  {
+    pixel_calls++;
+    while (len--)
+    {
+      write16(*data++);
+    }
+  }
+  void writeBytes(uint8_t *data, uint32_t len) override
+  {
+    pixel_calls++;
+    while (len--)
+    {
+      write(*data++);
+    }
+  }
+  void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) override
+  {
+    while (repeat--)
+    {
+      for (uint8_t i = 0; i < len; i++)
+      {
+        write(data[i]);
+      }
+    }
+  }
+  bool supportsZeroCopy(const void *data, bool big_endian) override { return zero_copy; }
+
+private:
+  uint8_t _cmd = 0;
+  uint8_t _arg[4];
+  uint8_t _args = 0;
+  uint8_t _hi = 0;
+  bool _half = false;
+  int16_t _x0 = 0, _x1 = 0, _y0 = 0, _y1 = 0, _cx = 0, _cy = 0;
+};
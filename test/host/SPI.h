@@ -0,0 +1,77 @@
+/*
+ * Host stand-in for the Arduino SPI library. Every transaction and byte is
+ * reported to host_spi_spy when a test sets one. Buffers sent with
+ * transfer(buf, n) come back overwritten, as on a real full duplex bus.
+ */
+#pragma once
+#include "Arduino.h"
+
+#define SPI_HAS_TRANSACTION
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+class SPISettings
+{
+public:
+  SPISettings() : speed(0), dataMode(SPI_MODE0) {}
+  SPISettings(uint32_t s, uint8_t, uint8_t m) : speed(s), dataMode(m) {}
+  uint32_t speed;
+  uint8_t dataMode;
+};
+
+class HostSpiSpy
+{
+public:
+  virtual ~HostSpiSpy() {}
+  virtual void beginTransaction(const SPISettings &) {}
+  virtual void endTransaction() {}
+  virtual void byte(uint8_t) {}
+};
+extern HostSpiSpy *host_spi_spy;
+
+class SPIClass
+{
+public:
+  void begin() {}
+  void end() {}
+  void beginTransaction(SPISettings s)
+  {
+    if (host_spi_spy)
+    {
+      host_spi_spy->beginTransaction(s);
+    }
+  }
+  void endTransaction()
+  {
+    if (host_spi_spy)
+    {
+      host_spi_spy->endTransaction();
+    }
+  }
+  uint8_t transfer(uint8_t d)
+  {
+    if (host_spi_spy)
+    {
+      host_spi_spy->byte(d);
+    }
+    return 0xEE;
+  }
+  uint16_t transfer16(uint16_t d)
+  {
+    transfer(d >> 8);
+    transfer(d);
+    return 0xEEEE;
+  }
+  void transfer(void *buf, size_t count)
+  {
+    uint8_t *p = (uint8_t *)buf;
+    while (count--)
+    {
+      transfer(*p);
+      *p++ = 0xEE;
+    }
+  }
+};
+extern SPIClass SPI;
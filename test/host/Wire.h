@@ -0,0 +1,5 @@
+/*
+ * Host stand-in, nothing in the host tests talks I2C
+ */
+#pragma once
+#include "Arduino.h"
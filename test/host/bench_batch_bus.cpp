@@ -0,0 +1,119 @@
+/*
+ * Window batching (user-034). Each scene is drawn on a cleared GC9A01
+ * three ways: straight to the bus, through Arduino_BatchBus, and through
+ * it with setBackground(BLACK). An Arduino_BusRecorder under the batching
+ * counts command and parameter bytes against pixel bytes, and FakePanelBus
+ * below that has to end up with the same panel RAM as the direct run.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "databus/Arduino_BatchBus.h"
+#include "databus/Arduino_BusRecorder.h"
+#include "FakePanelBus.h"
+
+static uint16_t reference[FAKE_PANEL_SIZE * FAKE_PANEL_SIZE];
+
+static void text(Arduino_GFX *gfx)
+{
+  gfx->setTextColor(WHITE);
+  gfx->setTextSize(1);
+  gfx->setCursor(40, 100);
+  gfx->print("Turntable 123");
+  gfx->setTextSize(2);
+  gfx->setCursor(40, 130);
+  gfx->print("Pos 7");
+}
+
+static void circles(Arduino_GFX *gfx)
+{
+  gfx->drawCircle(120, 120, 110, RED);
+  gfx->drawCircle(120, 120, 90, 0x7BEF);
+}
+
+static void lines(Arduino_GFX *gfx)
+{
+  for (int a = 0; a < 360; a += 30)
+  {
+    float r = a * DEGTORAD;
+    gfx->drawLine(120, 120, 120 + (100 * cos(r)), 120 + (100 * sin(r)), 0xFFE0);
+  }
+}
+
+static void aa_lines(Arduino_GFX *gfx)
+{
+  gfx->startWrite();
+  for (int a = 5; a < 360; a += 30)
+  {
+    float r = a * DEGTORAD;
+    gfx->writeAntialiasedLine(120, 120, 120 + (100 * cos(r)), 120 + (100 * sin(r)), 0xFFE0, BLACK);
+  }
+  gfx->endWrite();
+}
+
+static void fills(Arduino_GFX *gfx)
+{
+  gfx->fillCircle(120, 120, 60, GREEN);
+  gfx->fillTriangle(10, 10, 100, 30, 40, 90, BLUE);
+}
+
+static void thick(Arduino_GFX *gfx)
+{
+  gfx->drawThickLine(30, 200, 210, 40, 5, 0xF81F);
+}
+
+static const char *modes[] = {"direct", "batched", "batched+bg"};
+
+// returns the pixels that differ from the direct run
+static int run(void (*scene)(Arduino_GFX *gfx), int mode, Arduino_BusRecorder *recorder, FakePanelBus *panel)
+{
+  Arduino_BatchBus batch(recorder);
+  if (mode == 2)
+  {
+    batch.setBackground(BLACK);
+  }
+  Arduino_GC9A01 tft((mode) ? (Arduino_DataBus *)&batch : (Arduino_DataBus *)recorder, GFX_NOT_DEFINED, 0, true);
+  host_fake_clock = true; // panel init delays
+  tft.begin();
+  host_fake_clock = false;
+  tft.fillScreen(BLACK);
+  recorder->reset();
+  scene(&tft);
+
+  if (!mode)
+  {
+    memcpy(reference, panel->ram, sizeof(reference));
+    return 0;
+  }
+  int bad = 0;
+  for (int i = 0; i < FAKE_PANEL_SIZE * FAKE_PANEL_SIZE; i++)
+  {
+    bad += (panel->ram[i] != reference[i]);
+  }
+  return bad;
+}
+
+int main()
+{
+  static const struct
+  {
+    const char *name;
+    void (*draw)(Arduino_GFX *gfx);
+  } scenes[] = {{"text", text}, {"circles", circles}, {"lines", lines}, {"aa lines", aa_lines}, {"fills", fills}, {"thick line", thick}};
+
+  int errors = 0;
+  printf("command bytes / pixel bytes\n");
+  for (auto &s : scenes)
+  {
+    printf("%-10s", s.name);
+    for (int mode = 0; mode < 3; mode++)
+    {
+      FakePanelBus panel;
+      Arduino_BusRecorder recorder(&panel);
+      int bad = run(s.draw, mode, &recorder, &panel);
+      errors += bad;
+      printf("  %s %5u/%5u = %4.2f%s", modes[mode], recorder.getCommandBytes(), recorder.getPixelBytes(),
+             (double)recorder.getCommandBytes() / recorder.getPixelBytes(), bad ? " PANEL DIFFERS" : "");
+    }
+    printf("\n");
+  }
+  return (errors) ? 1 : 0;
+}
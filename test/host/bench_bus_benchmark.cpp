@@ -0,0 +1,140 @@
+/*
+ * Bus benchmark and selection (user-040). Two fake buses charge the fake
+ * clock a cost per call and a cost per byte that falls with the speed:
+ * bus A streams fast but every call is slow to set up, bus B is slower per
+ * byte but cheap per call. select() has to skip the speed verify rejects
+ * and pick the fastest overall. The choice is saved and loaded through an
+ * EEPROM that is closed, that the sketch already has open, and that is
+ * open but too small, and the sketch's own copy has to stay open.
+ */
+#include "databus/Arduino_BusBenchmark.h"
+#include "FakePanelBus.h"
+
+// one full screen through each of three methods, and 4 windows on each row
+#define FULL_SCREEN_BYTES (11 + (FAKE_PANEL_SIZE * FAKE_PANEL_SIZE * 2))
+#define EXPECTED_BYTES ((3 * FULL_SCREEN_BYTES) + (FAKE_PANEL_SIZE * 4 * (11 + (BUSBENCHMARK_WINDOW_PIXELS * 2))))
+
+static int errors = 0;
+
+static void expect(bool ok, const char *what)
+{
+  if (!ok)
+  {
+    errors++;
+    printf("FAIL: %s\n", what);
+  }
+}
+
+class TimedBus : public FakePanelBus
+{
+public:
+  TimedBus(uint32_t call_ns, uint32_t clocks_per_byte) : _call_ns(call_ns), _clocks_per_byte(clocks_per_byte) {}
+
+  void begin(int32_t speed, int8_t) override
+  {
+    _speed = speed;
+    cmd_bytes = 0;
+    data_bytes = 0;
+    windows = 0;
+  }
+  void writeCommand(uint8_t c) override { timed([&] { FakePanelBus::writeCommand(c); }); }
+  void write(uint8_t d) override { timed([&] { FakePanelBus::write(d); }); }
+  void write16(uint16_t d) override { timed([&] { FakePanelBus::write16(d); }); }
+  void writeRepeat(uint16_t p, uint32_t len) override { timed([&] { FakePanelBus::writeRepeat(p, len); }); }
+  void writePixels(uint16_t *data, uint32_t len) override { timed([&] { FakePanelBus::writePixels(data, len); }); }
+  void writeBytes(uint8_t *data, uint32_t len) override { timed([&] { FakePanelBus::writeBytes(data, len); }); }
+
+private:
+  // one call's cost for the outermost call only, FakePanelBus writes
+  // everything through write()
+  template <class F>
+  void timed(F f)
+  {
+    uint32_t before = cmd_bytes + data_bytes;
+    _depth++;
+    f();
+    _depth--;
+    if (_depth)
+    {
+      return;
+    }
+    _ns += _call_ns + ((uint64_t)(cmd_bytes + data_bytes - before) * _clocks_per_byte * 1000000000 / _speed);
+    host_fake_micros += _ns / 1000;
+    _ns %= 1000;
+  }
+
+  uint32_t _call_ns, _clocks_per_byte;
+  int32_t _speed = 1;
+  int _depth = 0;
+  uint64_t _ns = 0;
+};
+
+// the panel is taken to stop following above 30 MHz
+static bool verify(Arduino_DataBus *bus, int32_t speed, void *arg)
+{
+  return speed <= 30000000;
+}
+
+int main()
+{
+  TimedBus a(2000, 1), b(500, 1);
+  Arduino_BusBenchmark bench;
+  bench.addCandidate("A 30 MHz", &a, 30000000);
+  bench.addCandidate("B 20 MHz", &b, 20000000);
+  bench.addCandidate("B 40 MHz", &b, 40000000);
+
+  host_fake_clock = true;
+  int8_t selected = bench.select(verify, NULL, &Serial);
+  host_fake_clock = false;
+  printf("selected %s\n", bench.selectedName() ? bench.selectedName() : "none");
+  expect(selected == 1, "B at 20 MHz selected");
+
+  // what reached the panel in one run, select() began B again after it
+  gfx_bus_benchmark_t result;
+  host_fake_clock = true;
+  b.begin(20000000, GFX_NOT_DEFINED);
+  bench.run(&b, &result);
+  host_fake_clock = false;
+  printf("one run: %u command bytes, %u data bytes, %u windows\n", b.cmd_bytes, b.data_bytes, b.windows);
+  expect((b.cmd_bytes + b.data_bytes) == EXPECTED_BYTES, "bytes sent by one run");
+  expect(b.windows == (3 + (FAKE_PANEL_SIZE * 4)), "windows opened by one run");
+
+  // EEPROM closed: begun and ended here, the choice reaches flash
+  bench.save(16);
+  expect(EEPROM.length() == 0, "EEPROM begun by save() is ended");
+  expect(EEPROM.commits == 1, "save() commits");
+  Arduino_BusBenchmark again;
+  again.addCandidate("A 30 MHz", &a, 30000000);
+  again.addCandidate("B 20 MHz", &b, 20000000);
+  again.addCandidate("B 40 MHz", &b, 40000000);
+  expect(again.load(16) && (again.selected() == 1), "choice loads back");
+  expect(EEPROM.length() == 0, "EEPROM begun by load() is ended");
+  Arduino_BusBenchmark other;
+  other.addCandidate("A 30 MHz", &a, 30000000);
+  other.addCandidate("B 20 MHz", &b, 20000000);
+  expect(!other.load(16), "refused for a different candidate list");
+
+  // EEPROM the sketch has open: used and left open, its settings kept
+  EEPROM.begin(64);
+  EEPROM.write(0, 0x5A);
+  uint32_t ends = EEPROM.ends;
+  bench.save(16);
+  expect((EEPROM.length() == 64) && (EEPROM.ends == ends), "sketch's EEPROM left open by save()");
+  expect(EEPROM.read(0) == 0x5A, "sketch's setting kept by save()");
+  expect(again.load(16) && (again.selected() == 1), "choice loads from the open EEPROM");
+  expect((EEPROM.length() == 64) && (EEPROM.ends == ends), "sketch's EEPROM left open by load()");
+  EEPROM.end();
+
+  // open but too small: nothing read or written, still open
+  EEPROM.begin(8);
+  ends = EEPROM.ends;
+  uint32_t commits = EEPROM.commits;
+  printf("expected messages: ");
+  bench.save(16);
+  expect(!again.load(16), "load() refused by a small EEPROM");
+  expect((EEPROM.length() == 8) && (EEPROM.ends == ends) && (EEPROM.commits == commits), "small EEPROM left alone");
+  EEPROM.end();
+
+  printf("%s\n", errors ? "bus benchmark FAILED" : "bus benchmark ok");
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * Dirty tracking cost of pixel-at-a-time drawing (user-041): circles,
+ * diagonal lines and text outlines plot single pixels, each one goes
+ * through addDirty(). Prints the host time of the drawing and the pixels
+ * the following flush sends, so a cheaper path can be checked against the
+ * area it marks.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "canvas/Arduino_Canvas.h"
+#include "FakePanelBus.h"
+#include <chrono>
+
+static void measure(const char *what, uint8_t max_rects, void (*draw)(Arduino_Canvas *canvas))
+{
+  FakePanelBus bus;
+  Arduino_GC9A01 tft(&bus);
+  Arduino_Canvas canvas(240, 240, &tft);
+  host_fake_clock = true; // panel init delays
+  canvas.begin();
+  host_fake_clock = false;
+  canvas.setMaxDirtyRects(max_rects);
+  canvas.flush();
+
+  // the best of five rounds, the host is not quiet
+  double best = 0;
+  uint32_t pixels = 0;
+  for (int round = 0; round < 5; round++)
+  {
+    double us = 0;
+    pixels = 0;
+    for (int i = 0; i < 200; i++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      draw(&canvas);
+      us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+      canvas.flush();
+      pixels += canvas.getFlushPixels();
+    }
+    if ((round == 0) || (us < best))
+    {
+      best = us;
+    }
+  }
+  printf("%-10s %u rects: %7.1f us drawing per frame, %6u pixels flushed per frame\n", what, max_rects, best / 200, pixels / 200);
+}
+
+static void circles(Arduino_Canvas *canvas)
+{
+  for (int16_t r = 10; r < 110; r += 10)
+  {
+    canvas->drawCircle(120, 120, r, 0xFFFF);
+  }
+}
+
+static void needles(Arduino_Canvas *canvas)
+{
+  for (int16_t a = 0; a < 240; a += 30)
+  {
+    canvas->drawLine(120, 120, a, 0, 0xF800);
+    canvas->drawLine(120, 120, 239 - a, 239, 0x001F);
+  }
+}
+
+static void text(Arduino_Canvas *canvas)
+{
+  canvas->setCursor(10, 100);
+  canvas->setTextSize(1);
+  canvas->print("Loco 3 speed 126 fwd");
+}
+
+int main()
+{
+  static const uint8_t counts[] = {1, 4, CANVAS_DIRTY_RECTS};
+  for (uint8_t max_rects : counts)
+  {
+    measure("circles", max_rects, circles);
+    measure("needles", max_rects, needles);
+    measure("text", max_rects, text);
+  }
+  return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Canvas flush with and without a zero-copy bus (user-033). Over a bus that
+ * sends straight from memory, a nearly full-width dirty rect goes out as
+ * whole rows in one run instead of one transfer per row. Prints the
+ * transfers, pixels and host time of each flush and checks the panel
+ * against the canvas.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "canvas/Arduino_Canvas.h"
+#include "FakePanelBus.h"
+
+static int errors = 0;
+
+static void measure(const char *what, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  for (int zero_copy = 0; zero_copy < 2; zero_copy++)
+  {
+    FakePanelBus bus;
+    bus.zero_copy = zero_copy;
+    Arduino_GC9A01 tft(&bus);
+    Arduino_Canvas canvas(240, 240, &tft);
+    host_fake_clock = true; // panel init delays
+    canvas.begin();
+    host_fake_clock = false;
+    for (int16_t i = 0; i < 240; i++)
+    {
+      canvas.drawFastHLine(0, i, 240, (uint16_t)(i * 0x0841));
+    }
+    canvas.flush();
+
+    canvas.fillRect(x, y, w, h, 0xF81F);
+    canvas.drawLine(x, y, x + w - 1, y + h - 1, 0x07E0);
+    uint32_t calls = bus.pixel_calls;
+    uint32_t windows = bus.windows;
+    canvas.flush();
+
+    uint16_t *fb = canvas.getFramebuffer();
+    int bad = 0;
+    for (int i = 0; i < 240 * 240; i++)
+    {
+      bad += (bus.ram[i] != fb[i]);
+    }
+    errors += bad;
+    printf("%-18s %-9s %4u transfers %2u windows %6u pixels %5u us%s\n",
+           what, zero_copy ? "zero-copy" : "staged", bus.pixel_calls - calls, bus.windows - windows,
+           canvas.getFlushPixels(), canvas.getFlushTime(), bad ? "  PANEL DIFFERS" : "");
+  }
+}
+
+int main()
+{
+  measure("full screen", 0, 0, 240, 240);
+  measure("band 220x40", 10, 100, 220, 40);
+  measure("needle 60x60", 90, 90, 60, 60);
+  return (errors) ? 1 : 0;
+}
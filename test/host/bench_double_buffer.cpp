@@ -0,0 +1,155 @@
+/*
+ * Double-buffered canvas against the single one (user-044). The panel bus
+ * is modelled at 200 ns per byte (40 MHz SPI) on the fake clock. Its async
+ * transfers run "in the background", done once the clock passes their end,
+ * and any other byte waits for them as it would for DMA. Each 240x240 frame
+ * moves a 40 px horizontal band ("ticker") or that and a vertical one
+ * ("cross"), prints a number and then spends app_us on other work, so the
+ * figures are bus and app time only: the drawing and the back buffer
+ * catch-up cost no time here. Prints ms per frame and checks the panel
+ * against the canvas afterwards.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "canvas/Arduino_Canvas_DoubleBuffer.h"
+#include "FakePanelBus.h"
+
+#define NS_PER_BYTE 200
+
+class TimedPanelBus : public FakePanelBus
+{
+public:
+  uint64_t now_ns = 0;
+  uint64_t async_end = 0;
+  gfx_async_done_cb_t done = NULL;
+  void *done_arg = NULL;
+
+  void write(uint8_t d) override
+  {
+    if (_filling)
+    {
+      FakePanelBus::write(d);
+      return;
+    }
+    waitAsync();
+    FakePanelBus::write(d);
+    tick(NS_PER_BYTE);
+  }
+  void writeCommand(uint8_t c) override
+  {
+    waitAsync();
+    FakePanelBus::writeCommand(c);
+    tick(NS_PER_BYTE);
+  }
+  bool supportsAsync() override { return true; }
+  void writePixelsAsync(uint16_t *data, uint32_t len, gfx_async_done_cb_t cb, void *arg) override
+  {
+    waitAsync();
+    // the pixels land now, the clock only moves once something waits
+    _filling = true;
+    FakePanelBus::writePixels(data, len);
+    _filling = false;
+    async_end = now_ns + ((uint64_t)len * 2 * NS_PER_BYTE);
+    done = cb;
+    done_arg = arg;
+  }
+  bool isBusy() override
+  {
+    if (done && (now_ns >= async_end))
+    {
+      finish();
+    }
+    return done != NULL;
+  }
+  void waitAsync() override
+  {
+    if (done)
+    {
+      if (now_ns < async_end)
+      {
+        tick(async_end - now_ns);
+      }
+      finish();
+    }
+  }
+  void work(uint32_t us)
+  {
+    tick((uint64_t)us * 1000);
+  }
+
+private:
+  void tick(uint64_t ns)
+  {
+    now_ns += ns;
+    host_fake_micros = now_ns / 1000;
+  }
+  void finish()
+  {
+    gfx_async_done_cb_t cb = done;
+    done = NULL;
+    if (cb)
+    {
+      cb(done_arg);
+    }
+  }
+  bool _filling = false;
+};
+
+static int errors = 0;
+
+template <class Canvas>
+static double run(const char *what, bool cross, uint32_t app_us)
+{
+  TimedPanelBus bus;
+  Arduino_GC9A01 tft(&bus);
+  Canvas canvas(240, 240, &tft);
+  host_fake_clock = true;
+  canvas.begin();
+  canvas.fillScreen(BLACK);
+  canvas.flush();
+  bus.waitAsync();
+
+  const int frames = 60;
+  uint64_t start = bus.now_ns;
+  for (int f = 0; f < frames; f++)
+  {
+    canvas.fillRect(0, (f * 7) % 200, 240, 40, (uint16_t)(f * 2654435761u));
+    if (cross)
+    {
+      canvas.fillRect((f * 13) % 200, 0, 40, 240, (uint16_t)(f * 40503u));
+    }
+    canvas.setCursor(60, 110);
+    canvas.setTextColor(WHITE, BLACK);
+    canvas.setTextSize(3);
+    canvas.print(f);
+    bus.work(app_us);
+    canvas.flush();
+  }
+  bus.waitAsync();
+  double ms = (bus.now_ns - start) / 1e6 / frames;
+  host_fake_clock = false;
+
+  int bad = 0;
+  uint16_t *fb = canvas.getFramebuffer();
+  for (int i = 0; i < 240 * 240; i++)
+  {
+    bad += (fb[i] != bus.ram[i]);
+  }
+  errors += bad;
+  printf("%-7s %-6s app %2u ms: %5.1f ms per frame, last transfer %5.1f ms%s\n",
+         what, cross ? "cross" : "ticker", app_us / 1000, ms, canvas.getFlushTime() / 1000.0, bad ? "  PANEL DIFFERS" : "");
+  return ms;
+}
+
+int main()
+{
+  static const uint32_t app[] = {5000, 15000};
+  for (int cross = 0; cross < 2; cross++)
+  {
+    for (uint32_t app_us : app)
+    {
+      run<Arduino_Canvas>("single", cross, app_us);
+      run<Arduino_Canvas_DoubleBuffer>("double", cross, app_us);
+    }
+  }
+  return (errors) ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * Indexed canvas colour lookup and palette overflow (user-042). A 240x240
+ * noisy RGB gradient is drawn pixel by pixel, which overflows the palette
+ * twice and ends at mask level 2. Prints the host time of the drawing and
+ * checks that every pixel maps to its colour under the final mask.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "canvas/Arduino_Canvas_Indexed.h"
+#include "FakePanelBus.h"
+#include <chrono>
+#include <vector>
+
+class IndexedProbe : public Arduino_Canvas_Indexed
+{
+public:
+  using Arduino_Canvas_Indexed::Arduino_Canvas_Indexed;
+  uint8_t *framebuffer() { return _framebuffer; }
+  uint16_t mask() { return _color_mask; }
+  uint8_t level() { return _current_mask_level; }
+};
+
+int main()
+{
+  const int W = 240, H = 240;
+  std::vector<uint16_t> image(W * H);
+  uint32_t seed = 12345;
+  for (int y = 0; y < H; y++)
+  {
+    for (int x = 0; x < W; x++)
+    {
+      seed = (seed * 1103515245) + 12345;
+      int n = (seed >> 16) & 15;
+      int r = ((x * 255 / W) + n) & 255;
+      int g = ((y * 255 / H) + n) & 255;
+      int b = (((x + y) * 255 / (W + H)) + n) & 255;
+      image[(y * W) + x] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+  }
+
+  FakePanelBus bus;
+  Arduino_GC9A01 tft(&bus);
+  IndexedProbe canvas(W, H, &tft);
+  host_fake_clock = true; // panel init delays
+  canvas.begin();
+  host_fake_clock = false;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int y = 0; y < H; y++)
+  {
+    for (int x = 0; x < W; x++)
+    {
+      canvas.drawPixel(x, y, image[(y * W) + x]);
+    }
+  }
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  int bad = 0;
+  for (int i = 0; i < W * H; i++)
+  {
+    bad += (canvas.get_index_color(canvas.framebuffer()[i]) != (image[i] & canvas.mask()));
+  }
+  printf("mask level %u, %.2f ms drawing, %d pixels mapped to the wrong colour\n", canvas.level(), ms, bad);
+  return (bad) ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Strip canvas frame time against strip height (user-029). The scene, a
+ * fill, the pit circle, 12 marks, text and a thick bridge, is rendered
+ * strip by strip into FakePanelBus and once straight into memory; every
+ * strip height has to give the same panel. Prints the buffer each height
+ * needs, the best of 5 frame times (host CPU only, the bus costs nothing
+ * here) and the bytes each frame puts on the bus.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "canvas/Arduino_Canvas_Strip.h"
+#include "FakePanelBus.h"
+
+class MemoryGFX : public Arduino_GFX
+{
+public:
+  uint16_t ram[240 * 240];
+  MemoryGFX() : Arduino_GFX(240, 240) { memset(ram, 0, sizeof(ram)); }
+  void begin(int32_t) override {}
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override { ram[(y * 240) + x] = color; }
+};
+
+static void scene(Arduino_GFX *gfx, void *)
+{
+  gfx->fillScreen(0x0010);
+  gfx->drawCircle(120, 120, 90, 0xFFFF);
+  for (int i = 0; i < 12; i++)
+  {
+    gfx->fillCircle(120 + cos(i * 0.5236) * 90, 120 + sin(i * 0.5236) * 90, 4, 0x07E0);
+  }
+  gfx->setCursor(60, 100);
+  gfx->setTextColor(0xFFE0);
+  gfx->print("Position 3");
+  gfx->drawThickLine(50, 60, 190, 180, 5, 0xF800);
+}
+
+int main()
+{
+  FakePanelBus bus;
+  Arduino_GC9A01 tft(&bus);
+  Arduino_Canvas_Strip strip(240, 240, 80, &tft);
+  host_fake_clock = true; // panel init delays
+  strip.begin();
+  host_fake_clock = false;
+
+  MemoryGFX reference;
+  scene(&reference, NULL);
+
+  int errors = 0;
+  static const int16_t rows[] = {1, 2, 4, 8, 16, 32, 80};
+  for (int16_t r : rows)
+  {
+    strip.setStripRows(r);
+    uint32_t bytes = bus.cmd_bytes + bus.data_bytes;
+    uint32_t best = 0;
+    for (int k = 0; k < 5; k++)
+    {
+      strip.render(scene);
+      if ((k == 0) || (strip.getFrameTime() < best))
+      {
+        best = strip.getFrameTime();
+      }
+    }
+    int bad = 0;
+    for (int i = 0; i < 240 * 240; i++)
+    {
+      bad += (reference.ram[i] != bus.ram[i]);
+    }
+    errors += bad;
+    printf("rows %2d: buffer %5d bytes, frame %5u us, bus %6u bytes per frame%s\n",
+           r, r * 240 * 2, best, (bus.cmd_bytes + bus.data_bytes - bytes) / 5, bad ? "  PANEL DIFFERS" : "");
+  }
+  return (errors) ? 1 : 0;
+}
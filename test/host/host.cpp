@@ -0,0 +1,50 @@
+/*
+ * Globals and clock of the host Arduino stand-ins
+ */
+#include "Arduino.h"
+#include "SPI.h"
+#include "EEPROM.h"
+#include <chrono>
+
+HardwareSerial Serial;
+SPIClass SPI;
+EEPROMClass EEPROM;
+uint8_t host_eeprom_flash[HOST_EEPROM_FLASH];
+HostSpiSpy *host_spi_spy = NULL;
+void (*host_pin_hook)(int pin, int value) = NULL;
+
+bool host_fake_clock = false;
+unsigned long host_fake_micros = 0;
+static const std::chrono::steady_clock::time_point host_start = std::chrono::steady_clock::now();
+
+unsigned long micros()
+{
+  if (host_fake_clock)
+  {
+    return host_fake_micros;
+  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - host_start).count();
+}
+
+unsigned long millis()
+{
+  return micros() / 1000;
+}
+
+void delay(unsigned long ms)
+{
+  delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  if (host_fake_clock)
+  {
+    host_fake_micros += us;
+    return;
+  }
+  unsigned long start = micros();
+  while ((micros() - start) < us)
+  {
+  }
+}
@@ -0,0 +1,33 @@
+#!/bin/sh
+# Builds and runs the host tests and benchmarks against the Arduino
+# stand-ins in this directory. Run from anywhere:
+#   sh test/host/run.sh              all of them
+#   sh test/host/run.sh bench_strip  just one
+# A test exits non-zero on failure, benchmarks print their figures.
+HOST=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HOST/../.." && pwd)
+OUT=${OUT:-/tmp/gfx_host}
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:-"-std=c++17 -O2 -Wall -Wno-unused-parameter"}
+LIB="Arduino_G.cpp Arduino_GFX.cpp Arduino_TFT.cpp Arduino_DataBus.cpp Arduino_GFX_Alloc.cpp SSD1306Ascii.cpp
+  canvas/*.cpp databus/Arduino_HWSPI.cpp databus/Arduino_SPIBusManager.cpp
+  databus/Arduino_BatchBus.cpp databus/Arduino_BusBenchmark.cpp databus/Arduino_BusRecorder.cpp display/Arduino_GC9A01.cpp"
+
+mkdir -p "$OUT" || exit 1
+objs=""
+for src in $(cd "$ROOT" && echo $LIB) host.cpp; do
+  case $src in host.cpp) path="$HOST/$src" ;; *) path="$ROOT/$src" ;; esac
+  obj="$OUT/$(echo "$src" | tr / _).o"
+  $CXX $CXXFLAGS -I"$HOST" -I"$ROOT" -c "$path" -o "$obj" || exit 1
+  objs="$objs $obj"
+done
+
+names=$*
+[ -z "$names" ] && names=$(cd "$HOST" && ls test_*.cpp bench_*.cpp 2>/dev/null | sed 's/\.cpp$//')
+rc=0
+for name in $names; do
+  echo "== $name"
+  $CXX $CXXFLAGS -I"$HOST" -I"$ROOT" "$HOST/$name.cpp" $objs -o "$OUT/$name" || { rc=1; continue; }
+  "$OUT/$name" || rc=1
+done
+exit $rc
@@ -0,0 +1,201 @@
+/*
+ * Alpha drawing on Arduino_Canvas (user-049). drawAlphaBitmap(),
+ * fillAlphaMask() and fillRectAlpha() are checked against a per-channel
+ * scalar blend at every rotation and byte order, with rectangles partly
+ * off every edge. Alpha 0 has to leave a pixel untouched and alpha 255 has
+ * to write the source exactly, and the 5-bit blend has to stay within 2 LSB
+ * of an exact one.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "canvas/Arduino_Canvas.h"
+#include "FakePanelBus.h"
+#include <cmath>
+#include <vector>
+
+// odd width, so every other framebuffer row starts off a word boundary
+#define CANVAS_W 37
+#define CANVAS_H 29
+
+static int errors = 0;
+static int max_error = 0;
+
+static void fail(const char *what, int be, int rotation)
+{
+  errors++;
+  printf("FAIL: %s, big endian %d, rotation %d\n", what, be, rotation);
+}
+
+// fg over bg one channel at a time, alpha rounded to 0..32 as the canvas does
+static uint16_t scalar_blend(uint16_t fg, uint16_t bg, uint8_t alpha)
+{
+  if (alpha == 0)
+  {
+    return bg;
+  }
+  if (alpha == 0xFF)
+  {
+    return fg;
+  }
+  int a = (alpha + 4) >> 3;
+  auto ch = [a](int f, int b)
+  { return b + (int)floor((double)(f - b) * a / 32.0); };
+  return (ch(fg >> 11, bg >> 11) << 11) | (ch((fg >> 5) & 0x3F, (bg >> 5) & 0x3F) << 5) | ch(fg & 0x1F, bg & 0x1F);
+}
+
+// how far the 5-bit alpha lands from an exact blend, in channel LSBs
+static void track_error(uint16_t fg, uint16_t bg, uint8_t alpha, uint16_t got)
+{
+  double a = alpha / 255.0;
+  auto ch = [a](int f, int b)
+  { return (int)lround(b + (f - b) * a); };
+  int d[3] = {
+      abs(ch(fg >> 11, bg >> 11) - (got >> 11)),
+      abs(ch((fg >> 5) & 0x3F, (bg >> 5) & 0x3F) - ((got >> 5) & 0x3F)),
+      abs(ch(fg & 0x1F, bg & 0x1F) - (got & 0x1F))};
+  for (int i = 0; i < 3; i++)
+  {
+    if (d[i] > max_error)
+    {
+      max_error = d[i];
+    }
+  }
+}
+
+// canvas pixel (x, y) in the framebuffer, worked out here rather than
+// through the canvas' own rotation offsets
+static uint16_t read_pixel(Arduino_Canvas &canvas, int rotation, int16_t x, int16_t y)
+{
+  int16_t fx, fy;
+  switch (rotation)
+  {
+  case 1:
+    fx = CANVAS_W - 1 - y;
+    fy = x;
+    break;
+  case 2:
+    fx = CANVAS_W - 1 - x;
+    fy = CANVAS_H - 1 - y;
+    break;
+  case 3:
+    fx = y;
+    fy = CANVAS_H - 1 - x;
+    break;
+  default:
+    fx = x;
+    fy = y;
+  }
+  uint16_t c = canvas.getFramebuffer()[fy * CANVAS_W + fx];
+  return canvas.isBigEndian() ? (uint16_t)((c >> 8) | (c << 8)) : c;
+}
+
+static void check(int be, int rotation)
+{
+  FakePanelBus bus;
+  Arduino_GC9A01 tft(&bus);
+  Arduino_Canvas canvas(CANVAS_W, CANVAS_H, &tft, 0, 0, be);
+  host_fake_clock = true; // panel init delays
+  canvas.begin();
+  host_fake_clock = false;
+  canvas.setRotation(rotation);
+  int16_t cw = canvas.width(), ch = canvas.height();
+  std::vector<uint16_t> ref(cw * ch);
+  srand(rotation + 10 * be);
+  for (int16_t y = 0; y < ch; y++)
+  {
+    for (int16_t x = 0; x < cw; x++)
+    {
+      ref[y * cw + x] = rand();
+      canvas.drawPixel(x, y, ref[y * cw + x]);
+    }
+  }
+
+  for (int it = 0; it < 300; it++)
+  {
+    int16_t x = (rand() % (cw + 20)) - 10, y = (rand() % (ch + 20)) - 10;
+    int16_t w = (rand() % 25) + 1, h = (rand() % 25) + 1;
+    uint16_t color = rand();
+    std::vector<uint16_t> bitmap(w * h);
+    std::vector<uint8_t> alpha(w * h);
+    for (auto &v : bitmap)
+    {
+      v = rand();
+    }
+    // runs of 0 and 255 for the skip and copy paths, with blends between
+    int mode = rand() % 4;
+    for (auto &a : alpha)
+    {
+      int r = rand() % 4;
+      a = (mode == 0) ? 0 : (mode == 1) ? 0xFF : (r == 0) ? 0 : (r == 1) ? 0xFF : rand();
+    }
+
+    int kind = rand() % 3;
+    if (kind == 2)
+    {
+      // alpha 0 and 255 for the early returns, a negative width mirrored
+      uint8_t a = (mode == 0) ? 0 : (mode == 1) ? 0xFF : rand();
+      bool flip = rand() % 2;
+      canvas.fillRectAlpha(x, y, flip ? -w : w, h, color, a);
+      if (flip)
+      {
+        x -= w - 1;
+      }
+      std::fill(alpha.begin(), alpha.end(), a);
+    }
+    else if (kind == 1)
+    {
+      canvas.fillAlphaMask(x, y, alpha.data(), w, h, color);
+    }
+    else
+    {
+      canvas.drawAlphaBitmap(x, y, bitmap.data(), alpha.data(), w, h);
+    }
+
+    for (int16_t j = 0; j < h; j++)
+    {
+      for (int16_t i = 0; i < w; i++)
+      {
+        int16_t px = x + i, py = y + j;
+        if ((px < 0) || (py < 0) || (px >= cw) || (py >= ch))
+        {
+          continue;
+        }
+        uint16_t fg = (kind == 0) ? bitmap[j * w + i] : color;
+        uint16_t bg = ref[py * cw + px];
+        ref[py * cw + px] = scalar_blend(fg, bg, alpha[j * w + i]);
+        track_error(fg, bg, alpha[j * w + i], ref[py * cw + px]);
+      }
+    }
+  }
+
+  for (int16_t y = 0; y < ch; y++)
+  {
+    for (int16_t x = 0; x < cw; x++)
+    {
+      if (read_pixel(canvas, rotation, x, y) != ref[y * cw + x])
+      {
+        printf("pixel (%d, %d): %04X, expected %04X\n", x, y, read_pixel(canvas, rotation, x, y), ref[y * cw + x]);
+        fail("differs from the scalar blend", be, rotation);
+        return;
+      }
+    }
+  }
+}
+
+int main()
+{
+  for (int be = 0; be < 2; be++)
+  {
+    for (int rotation = 0; rotation < 4; rotation++)
+    {
+      check(be, rotation);
+    }
+  }
+  if (max_error > 2)
+  {
+    printf("FAIL: %d LSB from an exact blend\n", max_error);
+    errors++;
+  }
+
+  printf("%s\n", errors ? "canvas alpha FAILED" : "canvas alpha ok");
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * gfx_alloc()/gfx_free() bookkeeping: from the heap every free takes its
+ * buffer off the region's count, in an arena only the latest buffer is given
+ * back and any other free is reported and kept.
+ */
+#include "Arduino_GFX_Alloc.h"
+
+static int errors = 0;
+
+static void expect(bool ok, const char *what)
+{
+  if (!ok)
+  {
+    errors++;
+    printf("FAIL: %s\n", what);
+  }
+}
+
+int main()
+{
+  // heap, no arena reserved yet
+  void *a = gfx_alloc(100, GFX_MEM_INTERNAL);
+  void *b = gfx_alloc(30, GFX_MEM_INTERNAL);
+  void *c = gfx_alloc(64);
+  expect(a && b && c, "heap allocation");
+  expect(((uintptr_t)a & 3) == 0 && ((uintptr_t)b & 3) == 0, "heap buffers 4-byte aligned");
+  expect(gfx_arena_used(GFX_MEM_INTERNAL) == 100 + 32, "heap internal used");
+  expect(gfx_arena_used(GFX_MEM_LARGE) == 64, "heap large used");
+  gfx_free(a);
+  expect(gfx_arena_used(GFX_MEM_INTERNAL) == 32, "heap free in any order");
+  gfx_free(b);
+  gfx_free(c);
+  expect(gfx_arena_used(GFX_MEM_INTERNAL) == 0 && gfx_arena_used(GFX_MEM_LARGE) == 0, "heap all given back");
+  expect(gfx_arena_high_water(GFX_MEM_INTERNAL) == 132, "heap high water kept");
+
+  // arena
+  expect(gfx_arena_begin(256), "arena reserved");
+  expect(gfx_arena_size(GFX_MEM_INTERNAL) == 256 && gfx_arena_size(GFX_MEM_LARGE) == 0, "arena sizes");
+  a = gfx_alloc(100, GFX_MEM_INTERNAL);
+  b = gfx_alloc(30, GFX_MEM_INTERNAL);
+  expect(gfx_arena_used(GFX_MEM_INTERNAL) == 132, "arena used");
+  printf("expected message: ");
+  gfx_free(a);
+  expect(gfx_arena_used(GFX_MEM_INTERNAL) == 132, "arena keeps an older buffer");
+  gfx_free(b);
+  expect(gfx_arena_used(GFX_MEM_INTERNAL) == 100, "arena gives back the latest buffer");
+  expect(gfx_alloc(200, GFX_MEM_INTERNAL) == NULL, "arena full");
+  gfx_arena_print();
+
+  printf("%s\n", errors ? "gfx_alloc FAILED" : "gfx_alloc ok");
+  return errors ? 1 : 0;
+}
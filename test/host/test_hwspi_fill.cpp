@@ -0,0 +1,81 @@
+/*
+ * Fill paths of Arduino_HWSPI (user-036): writePattern() packs whole copies
+ * of the pattern into each buffered transfer and writeRepeat() fills the
+ * buffer once, so both have to put exactly repeat copies on the wire
+ * whatever the pattern length, including lengths that do not divide the
+ * buffer. The host SPI overwrites every buffer it sends, as the full duplex
+ * cores do. Also prints the host time of a 240x240 writeRepeat().
+ */
+#include "databus/Arduino_HWSPI.h"
+#include <chrono>
+#include <vector>
+
+class ByteLog : public HostSpiSpy
+{
+public:
+  std::vector<uint8_t> bytes;
+  void byte(uint8_t d) override { bytes.push_back(d); }
+};
+
+int main()
+{
+  ByteLog log;
+  host_spi_spy = &log;
+  Arduino_HWSPI bus(1, 2, &SPI);
+  bus.begin();
+  bus.beginWrite();
+
+  int errors = 0;
+  static const uint8_t lengths[] = {1, 2, 3, 5, 64, 65, 100};
+  static const uint32_t repeats[] = {0, 1, 2, 21, 22, 23, 1000};
+  for (uint8_t len : lengths)
+  {
+    for (uint32_t repeat : repeats)
+    {
+      std::vector<uint8_t> pattern(len);
+      for (int i = 0; i < len; i++)
+      {
+        pattern[i] = (i * 7) + 1;
+      }
+      log.bytes.clear();
+      bus.writePattern(pattern.data(), len, repeat);
+      std::vector<uint8_t> expect;
+      for (uint32_t r = 0; r < repeat; r++)
+      {
+        expect.insert(expect.end(), pattern.begin(), pattern.end());
+      }
+      if (log.bytes != expect)
+      {
+        errors++;
+        printf("FAIL: writePattern length %u, %u repeats\n", len, repeat);
+      }
+    }
+  }
+
+  static const uint32_t counts[] = {0, 1, 31, 32, 33, 57600};
+  for (uint32_t n : counts)
+  {
+    log.bytes.clear();
+    bus.writeRepeat(0x1234, n);
+    bool ok = (log.bytes.size() == (n * 2));
+    for (size_t i = 0; ok && (i < log.bytes.size()); i++)
+    {
+      ok = (log.bytes[i] == ((i & 1) ? 0x34 : 0x12));
+    }
+    if (!ok)
+    {
+      errors++;
+      printf("FAIL: writeRepeat %u pixels\n", n);
+    }
+  }
+
+  host_spi_spy = NULL;
+  auto start = std::chrono::steady_clock::now();
+  bus.writeRepeat(0xF800, 240 * 240);
+  double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  bus.endWrite();
+  printf("writeRepeat 240x240: %.0f us on the host\n", us);
+
+  printf("%s\n", errors ? "HWSPI fill FAILED" : "HWSPI fill ok");
+  return (errors) ? 1 : 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Nested save-under (user-050). On a canvas at every rotation and byte
+ * order, two layers are saved, drawn and restored 50 times, then a stack
+ * with a save too big for the pool and one past SAVE_UNDER_MAX_DEPTH is
+ * unwound: the framebuffer has to come back byte-identical with nothing
+ * left in the pool. A window with a non-zero output offset regenerates a
+ * procedural scene, and restore() has to put it back at the same panel
+ * position it was flushed to.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "canvas/Arduino_SaveUnder.h"
+#include "FakePanelBus.h"
+#include <vector>
+
+static int errors = 0;
+
+static void fail(const char *what, int be, int rotation)
+{
+  errors++;
+  printf("FAIL: %s, big endian %d, rotation %d\n", what, be, rotation);
+}
+
+static void check_canvas(int be, int rotation)
+{
+  FakePanelBus bus;
+  Arduino_GC9A01 tft(&bus);
+  Arduino_Canvas canvas(60, 44, &tft, 0, 0, be);
+  host_fake_clock = true; // panel init delays
+  canvas.begin();
+  host_fake_clock = false;
+  canvas.setRotation(rotation);
+  srand(rotation);
+  for (int16_t y = 0; y < canvas.height(); y++)
+  {
+    for (int16_t x = 0; x < canvas.width(); x++)
+    {
+      canvas.drawPixel(x, y, rand());
+    }
+  }
+  std::vector<uint16_t> before(canvas.getFramebuffer(), canvas.getFramebuffer() + (60 * 44));
+
+  Arduino_SaveUnder save_under(2000, &canvas);
+  save_under.begin();
+  for (int f = 0; f < 50; f++)
+  {
+    int16_t ax = (rand() % 80) - 10, ay = (rand() % 60) - 10;
+    int16_t bx = (rand() % 70) - 10, by = (rand() % 60) - 10;
+    save_under.save(ax, ay, 20, 15);
+    canvas.fillRect(ax, ay, 20, 15, 0xF800);
+    save_under.save(bx, by, 12, 12);
+    canvas.fillCircle(bx + 6, by + 6, 5, 0x07E0);
+    save_under.restore();
+    save_under.restore();
+    if (memcmp(before.data(), canvas.getFramebuffer(), 60 * 44 * 2))
+    {
+      fail("two layers not restored", be, rotation);
+      return;
+    }
+  }
+
+  // 300 pixels of pool: the second save does not fit, the fifth is past the
+  // depth, and what they did not save is left alone
+  Arduino_SaveUnder small(300, &canvas);
+  small.begin();
+  static const struct
+  {
+    int16_t x, y, w, h;
+    bool ok;
+  } stack[] = {{2, 2, 10, 10, true}, {0, 0, 20, 20, false}, {20, 5, 8, 8, true}, {-3, 30, 5, 5, true}, {30, 20, 6, 6, false}};
+  for (auto &s : stack)
+  {
+    if (small.save(s.x, s.y, s.w, s.h) != s.ok)
+    {
+      fail("unexpected save() result", be, rotation);
+    }
+    if (s.ok)
+    {
+      canvas.fillRect(s.x, s.y, s.w, s.h, 0x001F);
+    }
+  }
+  for (int i = 0; i < 5; i++)
+  {
+    small.restore();
+  }
+  if (small.getDepth() || small.getUsedPixels())
+  {
+    fail("pool not empty after unwinding", be, rotation);
+  }
+  if (memcmp(before.data(), canvas.getFramebuffer(), 60 * 44 * 2))
+  {
+    fail("failed saves restored something", be, rotation);
+  }
+}
+
+// procedural background in screen coordinates, nothing to read it back from
+static void scene(Arduino_GFX *gfx, void *)
+{
+  gfx->fillScreen(0x0010);
+  for (int16_t r = 90; r > 0; r -= 10)
+  {
+    gfx->fillCircle(100, 100, r, (uint16_t)(r * 613));
+  }
+  for (int16_t a = 0; a < 12; a++)
+  {
+    gfx->drawLine(100, 100, (a - 6) * 20, 0, 0xFFFF);
+  }
+}
+
+static void check_window(int be)
+{
+  const int16_t ox = 20, oy = 30; // the 200x200 screen sits there on the panel
+  FakePanelBus bus;
+  Arduino_GC9A01 tft(&bus);
+  host_fake_clock = true;
+  tft.begin();
+  host_fake_clock = false;
+  Arduino_Canvas_Window full(200, 200, 200 * 200, &tft, ox, oy, be);
+  full.begin();
+  full.setWindow(0, 0, 200, 200);
+  scene(&full, NULL);
+  full.flush();
+  std::vector<uint16_t> background(bus.ram, bus.ram + (FAKE_PANEL_SIZE * FAKE_PANEL_SIZE));
+
+  Arduino_Canvas_Window window(200, 200, 1600, &tft, ox, oy, be);
+  window.begin();
+  Arduino_SaveUnder save_under(3000, &window, scene);
+  save_under.begin();
+  for (int f = 0; f < 40; f++)
+  {
+    int16_t x = (f * 17) % 170, y = (f * 29) % 170; // the object stays on the 200x200 screen
+    save_under.save(x, y, 30, 30);
+    tft.fillRoundRect(ox + x, oy + y, 30, 30, 6, 0xFFE0);
+    save_under.restore();
+    if (memcmp(background.data(), bus.ram, sizeof(bus.ram)))
+    {
+      fail("window background not restored in place", be, 0);
+      return;
+    }
+  }
+}
+
+int main()
+{
+  for (int be = 0; be < 2; be++)
+  {
+    for (int rotation = 0; rotation < 4; rotation++)
+    {
+      check_canvas(be, rotation);
+    }
+    check_window(be);
+  }
+  printf("%s\n", errors ? "save-under FAILED" : "save-under ok");
+  return (errors) ? 1 : 0;
+}
@@ -0,0 +1,234 @@
+/*
+ * Interleaves a TFT, an OLED and an EEPROM on one Arduino_SPIBusManager and
+ * checks on every edge that transactions never overlap: no nested
+ * beginTransaction, never two chip selects low, no byte outside a
+ * transaction or under another device's settings, and no transaction left
+ * open once a draw call returns. A timer "interrupt" asks the EEPROM to save
+ * every 3 ms of bus time, so services also run in the middle of TFT slices.
+ */
+#include "databus/Arduino_HWSPI.h"
+#include "databus/Arduino_SPIBusManager.h"
+#include "SSD1306AsciiSpi.h"
+#include "fonts/allFonts.h"
+#include <map>
+#include <vector>
+
+enum
+{
+  TFT_CS = 10,
+  TFT_DC = 11,
+  OLED_CS = 20,
+  OLED_DC = 21,
+  EE_CS = 30
+};
+
+static std::map<int, uint32_t> speed_of = {{TFT_CS, 40000000}, {OLED_CS, 8000000}, {EE_CS, 2000000}};
+static int errors = 0;
+
+static void fail(const char *what)
+{
+  if (errors++ < 10)
+  {
+    printf("FAIL: %s\n", what);
+  }
+}
+
+class BusChecker : public HostSpiSpy
+{
+public:
+  bool open = false;
+  uint32_t open_speed = 0;
+  int selected = -1;
+  uint64_t ns = 0; // bus time
+  uint64_t next_tick = 3000000;
+  std::map<int, std::vector<uint8_t>> got;
+  Arduino_SPIBusManager *manager = NULL;
+  int8_t eeprom = GFX_NOT_DEFINED;
+
+  void beginTransaction(const SPISettings &s) override
+  {
+    if (open)
+    {
+      fail("nested transaction");
+    }
+    if (selected >= 0)
+    {
+      fail("transaction begins with a device selected");
+    }
+    open = true;
+    open_speed = s.speed;
+  }
+  void endTransaction() override
+  {
+    if (!open)
+    {
+      fail("end without begin");
+    }
+    if (selected >= 0)
+    {
+      fail("transaction ends with a device selected");
+    }
+    open = false;
+  }
+  void byte(uint8_t d) override
+  {
+    if (!open)
+    {
+      fail("byte outside a transaction");
+    }
+    if (selected < 0)
+    {
+      fail("byte with no device selected");
+    }
+    else
+    {
+      if (speed_of[selected] != open_speed)
+      {
+        fail("byte sent with another device's settings");
+      }
+      got[selected].push_back(d);
+    }
+    ns += 8000000000ULL / open_speed;
+    host_fake_micros = ns / 1000;
+    if (ns >= next_tick)
+    {
+      next_tick += 3000000;
+      manager->requestService(eeprom);
+    }
+  }
+  void pin(int p, int v)
+  {
+    if (!speed_of.count(p))
+    {
+      return; // dc pins
+    }
+    if (v == LOW)
+    {
+      if (!open)
+      {
+        fail("chip select low outside a transaction");
+      }
+      if ((selected >= 0) && (selected != p))
+      {
+        fail("two chip selects low");
+      }
+      selected = p;
+    }
+    else if (selected == p)
+    {
+      selected = -1;
+    }
+  }
+  void idle(const char *after)
+  {
+    if (open || (selected >= 0) || (manager->owner() != GFX_NOT_DEFINED))
+    {
+      printf("FAIL: bus still held after %s\n", after);
+      exit(1); // the next device would wait for ever
+    }
+  }
+};
+
+static BusChecker checker;
+static uint8_t ee_counter = 0;
+
+static void pin_hook(int pin, int value)
+{
+  checker.pin(pin, value);
+}
+
+static void eeprom_save(void *)
+{
+  SPI.transfer(0x02); // WRITE 0x0010
+  SPI.transfer(0x00);
+  SPI.transfer(0x10);
+  SPI.transfer(ee_counter++);
+}
+
+static void run(uint32_t slice_us)
+{
+  checker = BusChecker();
+  ee_counter = 0;
+  Arduino_SPIBusManager manager(&SPI);
+  checker.manager = &manager;
+
+  Arduino_HWSPI tft(TFT_DC, TFT_CS, &SPI);
+  tft.setBusManager(&manager, slice_us);
+  tft.begin(40000000, SPI_MODE0);
+  checker.eeprom = manager.addDevice(2000000, SPI_MODE0, 0, EE_CS);
+  manager.setService(checker.eeprom, eeprom_save);
+  SSD1306AsciiSpi oled;
+  oled.setBusManager(&manager);
+  oled.begin(&SH1106_128x64, OLED_CS, OLED_DC);
+  oled.setFont(System5x7);
+  checker.idle("setup");
+
+  static uint16_t px[240 * 240];
+  for (int i = 0; i < 240 * 240; i++)
+  {
+    px[i] = i * 31;
+  }
+  std::vector<uint8_t> expect;
+  for (int frame = 0; frame < 4; frame++)
+  {
+    tft.beginWrite();
+    tft.writeCommand(0x2C);
+    expect.push_back(0x2C);
+    if (frame & 1)
+    {
+      tft.writePixels(px, 240 * 240);
+      for (int i = 0; i < 240 * 240; i++)
+      {
+        expect.push_back(px[i] >> 8);
+        expect.push_back(px[i]);
+      }
+    }
+    else
+    {
+      tft.writeRepeat(0xF800 + frame, 240 * 240);
+      for (int i = 0; i < 240 * 240; i++)
+      {
+        expect.push_back(0xF8);
+        expect.push_back(frame);
+      }
+    }
+    tft.endWrite();
+    checker.idle("a TFT frame");
+
+    oled.setCursor(0, 0);
+    oled.print("frame ");
+    oled.print(frame);
+    checker.idle("OLED text");
+    oled.clear();
+    checker.idle("OLED clear");
+
+    if (manager.acquire(checker.eeprom)) // read status from the main loop
+    {
+      SPI.transfer(0x05);
+      SPI.transfer(0x00);
+      manager.release(checker.eeprom);
+    }
+    manager.poll();
+    checker.idle("poll");
+  }
+
+  bool tft_ok = checker.got[TFT_CS] == expect;
+  if (!tft_ok)
+  {
+    fail("TFT byte stream changed by the interleaving");
+  }
+  printf("slice %4u us: tft %zu bytes, oled %zu bytes, eeprom %zu bytes\n",
+         slice_us, checker.got[TFT_CS].size(), checker.got[OLED_CS].size(), checker.got[EE_CS].size());
+}
+
+int main()
+{
+  host_fake_clock = true;
+  host_spi_spy = &checker;
+  host_pin_hook = pin_hook;
+  run(0);
+  run(1000);
+  run(250);
+  printf("%s: %d errors\n", (errors) ? "FAILED" : "passed", errors);
+  return (errors) ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Sprite layer on a window that cannot draw (user-028). A window whose
+ * begin() was never called has no framebuffer and one with a zero buffer
+ * holds nothing: moving and redrawing a sprite has to skip it without
+ * touching the panel. A buffer larger than 32767 pixels and one smaller
+ * than a row have to composite the same panel as a direct draw.
+ */
+#include "display/Arduino_GC9A01.h"
+#include "canvas/Arduino_SpriteLayer.h"
+#include "FakePanelBus.h"
+
+#define SCREEN 120
+#define SPRITE_COLOR 0xF800
+
+static int errors = 0;
+static int draws = 0;
+
+static void expect(bool ok, const char *what)
+{
+  if (!ok)
+  {
+    errors++;
+    printf("FAIL: %s\n", what);
+  }
+}
+
+static void background(Arduino_GFX *gfx, void *arg)
+{
+  draws++;
+  for (int16_t y = 0; y < SCREEN; y += 8)
+  {
+    gfx->fillRect(0, y, SCREEN, 8, (y * 0x0841) | 0x001F);
+  }
+}
+
+static void sprite(Arduino_GFX *gfx, void *arg)
+{
+  int16_t *pos = (int16_t *)arg;
+  draws++;
+  gfx->fillRect(pos[0], pos[1], 30, 20, SPRITE_COLOR);
+}
+
+// what the panel should show with the sprite at pos
+static bool panel_matches(FakePanelBus *bus, const int16_t *pos)
+{
+  for (int16_t y = 0; y < SCREEN; y++)
+  {
+    for (int16_t x = 0; x < SCREEN; x++)
+    {
+      bool in = (x >= pos[0]) && (x < pos[0] + 30) && (y >= pos[1]) && (y < pos[1] + 20);
+      uint16_t c = in ? SPRITE_COLOR : (((y & ~7) * 0x0841) | 0x001F);
+      if (bus->ram[y * FAKE_PANEL_SIZE + x] != c)
+      {
+        printf("pixel (%d, %d): %04X, expected %04X\n", x, y, bus->ram[y * FAKE_PANEL_SIZE + x], c);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void check(int32_t buffer_pixels, bool begin, bool drawn, const char *what)
+{
+  FakePanelBus bus;
+  Arduino_GC9A01 tft(&bus);
+  Arduino_Canvas_Window window(SCREEN, SCREEN, buffer_pixels, &tft);
+  host_fake_clock = true; // panel init delays
+  if (begin)
+  {
+    window.begin();
+  }
+  else
+  {
+    tft.begin();
+  }
+  host_fake_clock = false;
+  uint32_t windows = bus.windows;
+
+  int16_t pos[2] = {-10, 5};
+  Arduino_SpriteLayer layer(&window, background);
+  int8_t id = layer.addSprite(sprite, pos);
+  draws = 0;
+  layer.redraw();
+  layer.moveSprite(id, pos[0], pos[1], 30, 20);
+  pos[0] = 70;
+  pos[1] = 90;
+  layer.moveSprite(id, pos[0], pos[1], 30, 20);
+  if (!drawn)
+  {
+    expect((draws == 0) && (bus.windows == windows), what);
+    return;
+  }
+  expect(panel_matches(&bus, pos), what);
+}
+
+int main()
+{
+  check(4000, false, false, "window without a framebuffer skipped");
+  check(0, true, false, "window without a buffer skipped");
+  check(40000, true, true, "buffer over 32767 pixels");
+  check(50, true, true, "buffer under a row");
+
+  printf("%s\n", errors ? "sprite layer FAILED" : "sprite layer ok");
+  return errors ? 1 : 0;
+}